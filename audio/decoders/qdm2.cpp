@@ -37,7 +37,6 @@
 #include "common/math.h"
 #include "common/rdft.h"
 #include "common/stream.h"
-#include "common/memstream.h"
 #include "common/bitstream.h"
 #include "common/textconsole.h"
 
@@ -213,9 +212,9 @@ private:
 	void fill_coding_method_array(sb_int8_array tone_level_idx, sb_int8_array tone_level_idx_temp,
 	                              sb_int8_array coding_method, int nb_channels,
 	                              int c, int superblocktype_2_3, int cm_table_select);
-	void synthfilt_build_sb_samples(Common::BitStream *gb, int length, int sb_min, int sb_max);
-	void init_quantized_coeffs_elem0(int8 *quantized_coeffs, Common::BitStream *gb, int length);
-	void init_tone_level_dequantization(Common::BitStream *gb, int length);
+	void synthfilt_build_sb_samples(Common::BitStreamMemory32LELSB *gb, int length, int sb_min, int sb_max);
+	void init_quantized_coeffs_elem0(int8 *quantized_coeffs, Common::BitStreamMemory32LELSB *gb, int length);
+	void init_tone_level_dequantization(Common::BitStreamMemory32LELSB *gb, int length);
 	void process_subpacket_9(QDM2SubPNode *node);
 	void process_subpacket_10(QDM2SubPNode *node, int length);
 	void process_subpacket_11(QDM2SubPNode *node, int length);
@@ -224,7 +223,7 @@ private:
 	void qdm2_decode_super_block(void);
 	void qdm2_fft_init_coefficient(int sub_packet, int offset, int duration,
 	                               int channel, int exp, int phase);
-	void qdm2_fft_decode_tones(int duration, Common::BitStream *gb, int b);
+	void qdm2_fft_decode_tones(int duration, Common::BitStreamMemory32LELSB *gb, int b);
 	void qdm2_decode_fft_packets(void);
 	void qdm2_fft_generate_tone(FFTTone *tone);
 	void qdm2_fft_tone_synthesizer(uint8 sub_packet);
@@ -669,6 +668,17 @@ void ff_mpa_synth_filter(int16 *synth_buf_ptr, int *synth_buf_offset,
 	*synth_buf_offset = offset;
 }
 
+/**
+ * Size in bytes of the bit stream over a packet of size bytes.
+ *
+ * BitStreamMemory32LELSB only reads whole 32-bit values, so the size is
+ * rounded up. Packets all lie inside _compressedData, whose zeroed padding
+ * covers the extra bytes of the last packet.
+ */
+static inline uint32 packetStreamSize(uint32 size) {
+	return (size + 3) & ~3;
+}
+
 /**
  * parses a vlc code, faster then get_vlc()
  * @param bits is the number of bits which will be read at once, must be
@@ -677,7 +687,7 @@ void ff_mpa_synth_filter(int16 *synth_buf_ptr, int *synth_buf_offset,
  *                  read the longest vlc code
  *                  = (max_vlc_length + bits - 1) / bits
  */
-static int getVlc2(Common::BitStream *s, int16 (*table)[2], int bits, int maxDepth) {
+static int getVlc2(Common::BitStreamMemory32LELSB *s, int16 (*table)[2], int bits, int maxDepth) {
 	int index = s->peekBits(bits);
 	int code = table[index][0];
 	int n = table[index][1];
@@ -1216,7 +1226,10 @@ QDM2Stream::QDM2Stream(Common::SeekableReadStream *extraData, DisposeAfterUse::F
 	rndTableInit();
 	initNoiseSamples();
 
-	_compressedData = new uint8[_packetSize];
+	// Zeroed padding for bit streams reading the last packet a whole
+	// 32-bit value at a time
+	_compressedData = new uint8[_packetSize + FF_INPUT_BUFFER_PADDING_SIZE];
+	memset(_compressedData + _packetSize, 0, FF_INPUT_BUFFER_PADDING_SIZE);
 
 	if (disposeExtraData == DisposeAfterUse::YES)
 		delete extraData;
@@ -1227,7 +1240,7 @@ QDM2Stream::~QDM2Stream() {
 	delete[] _compressedData;
 }
 
-static int qdm2_get_vlc(Common::BitStream *gb, VLC *vlc, int flag, int depth) {
+static int qdm2_get_vlc(Common::BitStreamMemory32LELSB *gb, VLC *vlc, int flag, int depth) {
 	int value = getVlc2(gb, vlc->table, vlc->bits, depth);
 
 	// stage-2, 3 bits exponent escape sequence
@@ -1246,7 +1259,7 @@ static int qdm2_get_vlc(Common::BitStream *gb, VLC *vlc, int flag, int depth) {
 	return value;
 }
 
-static int qdm2_get_se_vlc(VLC *vlc, Common::BitStream *gb, int depth)
+static int qdm2_get_se_vlc(VLC *vlc, Common::BitStreamMemory32LELSB *gb, int depth)
 {
 	int value = qdm2_get_vlc(gb, vlc, 0, depth);
 
@@ -1606,7 +1619,7 @@ void QDM2Stream::fill_coding_method_array(sb_int8_array tone_level_idx, sb_int8_
  * @param sb_min    lower subband processed (sb_min included)
  * @param sb_max    higher subband processed (sb_max excluded)
  */
-void QDM2Stream::synthfilt_build_sb_samples(Common::BitStream *gb, int length, int sb_min, int sb_max) {
+void QDM2Stream::synthfilt_build_sb_samples(Common::BitStreamMemory32LELSB *gb, int length, int sb_min, int sb_max) {
 	int sb, j, k, n, ch, run, channels;
 	int joined_stereo, zero_encoding, chs;
 	int type34_first;
@@ -1786,7 +1799,7 @@ void QDM2Stream::synthfilt_build_sb_samples(Common::BitStream *gb, int length, i
  * @param gb        bitreader context
  * @param length    packet length in bits
  */
-void QDM2Stream::init_quantized_coeffs_elem0(int8 *quantized_coeffs, Common::BitStream *gb, int length) {
+void QDM2Stream::init_quantized_coeffs_elem0(int8 *quantized_coeffs, Common::BitStreamMemory32LELSB *gb, int length) {
 	int i, k, run, level, diff;
 
 	if ((length - gb->pos()) < 16)
@@ -1820,7 +1833,7 @@ void QDM2Stream::init_quantized_coeffs_elem0(int8 *quantized_coeffs, Common::Bit
  * @param gb        bitreader context
  * @param length    packet length in bits
  */
-void QDM2Stream::init_tone_level_dequantization(Common::BitStream *gb, int length) {
+void QDM2Stream::init_tone_level_dequantization(Common::BitStreamMemory32LELSB *gb, int length) {
 	int sb, j, k, n, ch;
 
 	for (ch = 0; ch < _channels; ch++) {
@@ -1886,8 +1899,7 @@ void QDM2Stream::init_tone_level_dequantization(Common::BitStream *gb, int lengt
 void QDM2Stream::process_subpacket_9(QDM2SubPNode *node) {
 	int i, j, k, n, ch, run, level, diff;
 
-	Common::MemoryReadStream d(node->packet->data, node->packet->size*8);
-	Common::BitStream32LELSB gb(&d);
+	Common::BitStreamMemory32LELSB gb(node->packet->data, packetStreamSize(node->packet->size));
 
 	n = coeff_per_sb_for_avg[_coeffPerSbSelect][QDM2_SB_USED(_subSampling) - 1] + 1; // same as averagesomething function
 
@@ -1920,8 +1932,7 @@ void QDM2Stream::process_subpacket_9(QDM2SubPNode *node) {
  * @param length    packet length in bits
  */
 void QDM2Stream::process_subpacket_10(QDM2SubPNode *node, int length) {
-	Common::MemoryReadStream d(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : node->packet->size*8));
-	Common::BitStream32LELSB gb(&d);
+	Common::BitStreamMemory32LELSB gb(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : packetStreamSize(node->packet->size)));
 
 	if (length != 0) {
 		init_tone_level_dequantization(&gb, length);
@@ -1938,8 +1949,7 @@ void QDM2Stream::process_subpacket_10(QDM2SubPNode *node, int length) {
  * @param length    packet length in bit
  */
 void QDM2Stream::process_subpacket_11(QDM2SubPNode *node, int length) {
-	Common::MemoryReadStream d(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : node->packet->size*8));
-	Common::BitStream32LELSB gb(&d);
+	Common::BitStreamMemory32LELSB gb(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : packetStreamSize(node->packet->size)));
 
 	if (length >= 32) {
 		int c = gb.getBits(13);
@@ -1959,8 +1969,7 @@ void QDM2Stream::process_subpacket_11(QDM2SubPNode *node, int length) {
  * @param length    packet length in bits
  */
 void QDM2Stream::process_subpacket_12(QDM2SubPNode *node, int length) {
-	Common::MemoryReadStream d(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : node->packet->size*8));
-	Common::BitStream32LELSB gb(&d);
+	Common::BitStreamMemory32LELSB gb(((node == NULL) ? _emptyBuffer : node->packet->data), ((node == NULL) ? 0 : packetStreamSize(node->packet->size)));
 
 	synthfilt_build_sb_samples(&gb, length, 8, QDM2_SB_USED(_subSampling));
 }
@@ -2014,8 +2023,7 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 
 	average_quantized_coeffs(); // average elements in quantized_coeffs[max_ch][10][8]
 
-	Common::MemoryReadStream *d = new Common::MemoryReadStream(_compressedData, _packetSize*8);
-	Common::BitStream *gb = new Common::BitStream32LELSB(d);
+	Common::BitStreamMemory32LELSB *gb = new Common::BitStreamMemory32LELSB(_compressedData, packetStreamSize(_packetSize));
 	//qdm2_decode_sub_packet_header
 	header.type = gb->getBits(8);
 
@@ -2047,9 +2055,7 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 	packet_bytes = (_packetSize - gb->pos() / 8);
 
 	delete gb;
-	delete d;
-	d = new Common::MemoryReadStream(header.data, header.size*8);
-	gb = new Common::BitStream32LELSB(d);
+	gb = new Common::BitStreamMemory32LELSB(header.data, packetStreamSize(header.size));
 
 	if (header.type == 2 || header.type == 4 || header.type == 5) {
 		int csum = 257 * gb->getBits(8) + 2 * gb->getBits(8);
@@ -2080,9 +2086,7 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 
 			// seek to next block
 			delete gb;
-			delete d;
-			d = new Common::MemoryReadStream(header.data, header.size*8);
-			gb = new Common::BitStream32LELSB(d);
+			gb = new Common::BitStreamMemory32LELSB(header.data, packetStreamSize(header.size));
 			gb->skip(next_index*8);
 
 			if (next_index >= header.size)
@@ -2133,7 +2137,6 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 		if (packet->type == 8) {
 			error("Unsupported packet type 8");
 			delete gb;
-			delete d;
 			return;
 		} else if (packet->type >= 9 && packet->type <= 12) {
 			// packets for MPEG Audio like Synthesis Filter
@@ -2147,7 +2150,6 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 		} else if (packet->type == 15) {
 			error("Unsupported packet type 15");
 			delete gb;
-			delete d;
 			return;
 		} else if (packet->type >= 16 && packet->type < 48 && !fft_subpackets[packet->type - 16]) {
 			// packets for FFT
@@ -2166,7 +2168,6 @@ void QDM2Stream::qdm2_decode_super_block(void) {
 	}
 // ****************************************************************
 	delete gb;
-	delete d;
 }
 
 void QDM2Stream::qdm2_fft_init_coefficient(int sub_packet, int offset, int duration,
@@ -2182,7 +2183,7 @@ void QDM2Stream::qdm2_fft_init_coefficient(int sub_packet, int offset, int durat
 	_fftCoefsIndex++;
 }
 
-void QDM2Stream::qdm2_fft_decode_tones(int duration, Common::BitStream *gb, int b) {
+void QDM2Stream::qdm2_fft_decode_tones(int duration, Common::BitStreamMemory32LELSB *gb, int b) {
 	int channel, stereo, phase, exp;
 	int local_int_4,  local_int_8,  stereo_phase,  local_int_10;
 	int local_int_14, stereo_exp, local_int_20, local_int_28;
@@ -2291,8 +2292,7 @@ void QDM2Stream::qdm2_decode_fft_packets(void) {
 			return;
 
 		// decode FFT tones
-		Common::MemoryReadStream d(packet->data, packet->size*8);
-		Common::BitStream32LELSB gb(&d);
+		Common::BitStreamMemory32LELSB gb(packet->data, packetStreamSize(packet->size));
 
 		if (packet->type >= 32 && packet->type < 48 && !fft_subpackets[packet->type - 16])
 			unknown_flag = 1;
@@ -24,12 +24,13 @@
 #define BACKENDS_GRAPHICS_NULL_H
 
 #include "backends/graphics/graphics.h"
+#include "graphics/surface.h"
 
 static const OSystem::GraphicsMode s_noGraphicsModes[] = { {0, 0, 0} };
 
 class NullGraphicsManager : public GraphicsManager {
 public:
-	virtual ~NullGraphicsManager() {}
+	virtual ~NullGraphicsManager() { _screen.free(); }
 
 	bool hasFeature(OSystem::Feature f) { return false; }
 	void setFeatureState(OSystem::Feature f, bool enable) {}
@@ -48,20 +49,35 @@ public:
 		list.push_back(Graphics::PixelFormat::createFormatCLUT8());
 		return list;
 	}
-	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) {}
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format = NULL) {
+		// Keep the game screen around so the event recorder can checksum it
+		if (_screen.w != (int16)width || _screen.h != (int16)height) {
+			_screen.free();
+			_screen.create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+		}
+	}
 	virtual int getScreenChangeID() const { return 0; }
 
 	void beginGFXTransaction() {}
 	OSystem::TransactionError endGFXTransaction() { return OSystem::kTransactionSuccess; }
 
-	int16 getHeight() { return 0; }
-	int16 getWidth() { return 0; }
+	int16 getHeight() { return _screen.h; }
+	int16 getWidth() { return _screen.w; }
 	void setPalette(const byte *colors, uint start, uint num) {}
 	void grabPalette(byte *colors, uint start, uint num) {}
-	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
-	Graphics::Surface *lockScreen() { return NULL; }
+	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {
+		if (!_screen.pixels || x < 0 || y < 0 || x + w > _screen.w || y + h > _screen.h)
+			return;
+		const byte *src = (const byte *)buf;
+		for (int i = 0; i < h; ++i, src += pitch)
+			memcpy(_screen.getBasePtr(x, y + i), src, w);
+	}
+	Graphics::Surface *lockScreen() { return _screen.pixels ? &_screen : NULL; }
 	void unlockScreen() {}
-	void fillScreen(uint32 col) {}
+	void fillScreen(uint32 col) {
+		if (_screen.pixels)
+			memset(_screen.pixels, col, _screen.pitch * _screen.h);
+	}
 	void updateScreen() {}
 	void setShakePos(int shakeOffset) {}
 	void setFocusRectangle(const Common::Rect& rect) {}
@@ -80,6 +96,9 @@ public:
 	void warpMouse(int x, int y) {}
 	void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale = false, const Graphics::PixelFormat *format = NULL) {}
 	void setCursorPalette(const byte *colors, uint start, uint num) {}
+
+private:
+	Graphics::Surface _screen;
 };
 
 #endif
@@ -69,7 +69,20 @@ sSDL_Surface * sSDL_CreateRGBSurface (Uint32 flags,
 
 int sSDL_SetColors(sSDL_Surface *screen, SDL_Color *colors, int firstcolor, int ncolors)
 {
-	memcpy(screen->palette, colors+firstcolor, sizeof(SDL_Color)*ncolors);
+	memcpy(screen->palette + firstcolor, colors, sizeof(SDL_Color)*ncolors);
+
+	// Convert the changed entries once here instead of for every pixel
+	// blitted. The 32 bit entries go through RGB565 as well, so that they
+	// match what Normal1x produces from _tmpscreen.
+	for (int i = firstcolor; i < firstcolor + ncolors; ++i) {
+		const SDL_Color &col = screen->palette[i];
+		const Uint16 c = ((col.r >> 3) << 11) | ((col.g >> 2) << 5) | (col.b >> 3);
+		const Uint32 r = (c >> 11) << 3;
+		const Uint32 g = ((c >> 5) & 63) << 2;
+		const Uint32 b = (c & 31) << 3;
+		screen->palette16[i] = c;
+		screen->palette32[i] = 0xFF000000 | (b << 16) | (g << 8) | r;
+	}
 	return 0;
 }
 
@@ -87,19 +100,36 @@ int sSDL_BlitSurface (sSDL_Surface *src, SDL_Rect *srcrect, sSDL_Surface *dst, S
 
 	assert(src->pitch == src->w);
 	assert(dst->pitch == 2*dst->w);
+	const unsigned char *s = (const unsigned char *)src->pixels + srcrect->y*src->pitch + srcrect->x;
+	unsigned short *d = (unsigned short *)dst->pixels + dstrect->y*dst->w + dstrect->x;
 	for(int y = 0; y < bHeight; ++y)
+	{
 		for(int x = 0; x < bWidth; ++x)
-		{
-			unsigned char c = ((unsigned char *)src->pixels)[(y+srcrect->y)*src->pitch+x+srcrect->x];
-			SDL_Color &col = src->palette[c];
-			unsigned short real_color = (((col.r) >> 3) << 11) |
-									(((col.g) >> 2) << 5) |
-									(((col.b) >> 3));
-			((unsigned short *)dst->pixels)[(y+dstrect->y)*dst->w+x+dstrect->x] = real_color;
-		}
+			d[x] = src->palette16[s[x]];
+		s += src->pitch;
+		d += dst->w;
+	}
 	return 0;
 }
 
+/**
+ * Convert a rect of an 8 bit surface straight into the 32 bit hardware
+ * screen. This is the same as blitting it to _tmpscreen and running
+ * Normal1x on the result, in a single pass over the pixels.
+ */
+static void sSDL_ConvertRect(const sSDL_Surface *src, int srcX, int srcY, uint8 *dstPtr, uint32 dstPitch, int width, int height)
+{
+	const unsigned char *s = (const unsigned char *)src->pixels + srcY*src->pitch + srcX;
+	for(int y = 0; y < height; ++y)
+	{
+		Uint32 *d = (Uint32 *)dstPtr;
+		for(int x = 0; x < width; ++x)
+			d[x] = src->palette32[s[x]];
+		s += src->pitch;
+		dstPtr += dstPitch;
+	}
+}
+
 int sSDL_BlitSurface_Alphakey (SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect)
 {
 	SDL_Rect rs;
@@ -211,7 +241,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #ifdef USE_OSD
 	_osdSurface(0), _osdAlpha(SDL_ALPHA_TRANSPARENT), _osdFadeStartTime(0),
 #endif
-	_hwscreen(0), _screen(0), _tmpscreen(0),
+	_hwscreen(0), _screen(0), _tmpscreen(0), _tmpscreenStale(false),
 #ifdef USE_RGB_COLOR
 	_screenFormat(Graphics::PixelFormat::createFormatCLUT8()),
 	_cursorFormat(Graphics::PixelFormat::createFormatCLUT8()),
@@ -245,6 +275,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_mouseBackup.x = _mouseBackup.y = _mouseBackup.w = _mouseBackup.h = 0;
 
 	memset(&_mouseCurState, 0, sizeof(_mouseCurState));
+	memset(&_updateStats, 0, sizeof(_updateStats));
 
 	_graphicsMutex = g_system->createMutex();
 
@@ -309,7 +340,8 @@ bool SurfaceSdlGraphicsManager::hasFeature(OSystem::Feature f) {
 		(f == OSystem::kFeatureFullscreenMode) ||
 		(f == OSystem::kFeatureAspectRatioCorrection) ||
 		(f == OSystem::kFeatureCursorPalette) ||
-		(f == OSystem::kFeatureIconifyWindow);
+		(f == OSystem::kFeatureIconifyWindow) ||
+		(f == OSystem::kFeatureDirectScreenAccess);
 }
 
 void SurfaceSdlGraphicsManager::setFeatureState(OSystem::Feature f, bool enable) {
@@ -890,6 +922,7 @@ bool SurfaceSdlGraphicsManager::loadGFXMode() {
 
 	if (_tmpscreen == NULL)
 		error("allocating _tmpscreen failed");
+	_tmpscreenStale = true;
 
 	_overlayscreen = SDL_CreateRGBSurface(SDL_SWSURFACE, _videoMode.overlayWidth, _videoMode.overlayHeight,
 						16,
@@ -1144,17 +1177,32 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		SDL_Rect dst;
 		uint32 srcPitch, dstPitch;
 		SDL_Rect *lastRect = _dirtyRectList + _numDirtyRects;
+		uint32 ticks = SDL_GetTicks(), lastTicks;
 
-		for (r = _dirtyRectList; r != lastRect; ++r) {
-			dst = *r;
-			dst.x++;	// Shift rect by one since 2xSai needs to access the data around
-			dst.y++;	// any pixel to scale it, and we want to avoid mem access crashes.
+		// Without scaling, the palette lookup and the conversion to the
+		// hardware screen format are done in one pass straight from the
+		// game screen, and _tmpscreen is left alone. It is only brought up
+		// to date again when something else needs it.
+		const bool fused = (scalerProc == Normal1x && scale1 == 1);
 
-//			warning("src rect: %d,%d,%d,%d, dst rect: %d,%d,%d,%d\n", r->x, r->y, r->w, r->h, dst.x, dst.y, dst.w, dst.h);
-			if (sSDL_BlitSurface(origSurf, r, srcSurf, &dst) != 0)
-				error("SDL_BlitSurface failed: %s", SDL_GetError());
+		if (fused) {
+			_tmpscreenStale = true;
+		} else {
+			for (r = _dirtyRectList; r != lastRect; ++r) {
+				dst = *r;
+				dst.x++;	// Shift rect by one since 2xSai needs to access the data around
+				dst.y++;	// any pixel to scale it, and we want to avoid mem access crashes.
+
+//				warning("src rect: %d,%d,%d,%d, dst rect: %d,%d,%d,%d\n", r->x, r->y, r->w, r->h, dst.x, dst.y, dst.w, dst.h);
+				if (sSDL_BlitSurface(origSurf, r, srcSurf, &dst) != 0)
+					error("SDL_BlitSurface failed: %s", SDL_GetError());
+			}
 		}
 
+		lastTicks = ticks;
+		ticks = SDL_GetTicks();
+		_updateStats.convert += ticks - lastTicks;
+
 //		SDL_LockSurface(srcSurf);
 		SDL_LockSurface(_hwscreen);
 
@@ -1181,8 +1229,12 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				assert(scalerProc != NULL);
 				//scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
 				//	(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwscreen->pixels + rx1 * 4 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				if (fused)
+					sSDL_ConvertRect(origSurf, r->x, r->y,
+						(byte *)_hwscreen->pixels + rx1 * 4 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				else
+					scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+						(byte *)_hwscreen->pixels + rx1 * 4 + dst_y * dstPitch, dstPitch, r->w, dst_h);
 			}
 
 			r->x = rx1;
@@ -1198,6 +1250,10 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 //		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwscreen);
 
+		lastTicks = ticks;
+		ticks = SDL_GetTicks();
+		_updateStats.scale += ticks - lastTicks;
+
 		// Readjust the dirty rect list in case we are doing a full update.
 		// This is necessary if shaking is active.
 		if (_forceFull) {
@@ -1285,8 +1341,21 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		}
 #endif
 
+		lastTicks = ticks;
+		ticks = SDL_GetTicks();
+		_updateStats.overlay += ticks - lastTicks;
+
 		// Finally, blit all our changes to the screen
 		SDL_UpdateRects(_hwscreen, _numDirtyRects, _dirtyRectList);
+
+		_updateStats.present += SDL_GetTicks() - ticks;
+
+		if (++_updateStats.frames == kUpdateStatsFrames) {
+			debug(2, "Screen updates: %d frames, convert %d ms, scale %d ms, overlay %d ms, present %d ms",
+				_updateStats.frames, _updateStats.convert, _updateStats.scale,
+				_updateStats.overlay, _updateStats.present);
+			memset(&_updateStats, 0, sizeof(_updateStats));
+		}
 	}
 
 	_numDirtyRects = 0;
@@ -1431,6 +1500,26 @@ void SurfaceSdlGraphicsManager::unlockScreen() {
 	g_system->unlockMutex(_graphicsMutex);
 }
 
+void SurfaceSdlGraphicsManager::unlockScreenRect(const Common::Rect &rect) {
+	assert(_transactionMode == kTransactionNone);
+
+	// paranoia check
+	assert(_screenIsLocked);
+	_screenIsLocked = false;
+
+	// _screen is what internUpdateScreen() converts and scales from, so
+	// only the changed area needs to be updated, just as if it had been
+	// passed to copyRectToScreen().
+	if (!rect.isEmpty()) {
+		assert(rect.left >= 0 && rect.right <= _videoMode.screenWidth);
+		assert(rect.top >= 0 && rect.bottom <= _videoMode.screenHeight);
+		addDirtyRect(rect.left, rect.top, rect.width(), rect.height());
+	}
+
+	// Finally unlock the graphics mutex
+	g_system->unlockMutex(_graphicsMutex);
+}
+
 void SurfaceSdlGraphicsManager::fillScreen(uint32 col) {
 	Graphics::Surface *screen = lockScreen();
 	if (screen && screen->pixels)
@@ -1689,6 +1778,13 @@ void SurfaceSdlGraphicsManager::clearOverlay() {
 //	if (SDL_BlitSurface(_screen, &src, _tmpscreen, &dst) != 0)
 //		error("SDL_BlitSurface failed: %s", SDL_GetError());
 
+	// The screen updates may have bypassed _tmpscreen
+	if (_tmpscreenStale) {
+		if (sSDL_BlitSurface(_screen, &src, _tmpscreen, &dst) != 0)
+			error("SDL_BlitSurface failed: %s", SDL_GetError());
+		_tmpscreenStale = false;
+	}
+
 //	SDL_LockSurface(_tmpscreen);
 	SDL_LockSurface(_overlayscreen);
 	_scalerProc((byte *)(_tmpscreen->pixels) + _tmpscreen->pitch + 2, _tmpscreen->pitch,
@@ -84,6 +84,8 @@ typedef struct sSDL_Surface {
 	struct private_hwdata *hwdata;
 
 	SDL_Color palette[256];
+	Uint16 palette16[256];			/**< palette in RGB565, for the scaler input */
+	Uint32 palette32[256];			/**< palette in the 32 bit hardware screen format */
 
 	/** clipping information */
 	SDL_Rect clip_rect;			/**< Read-only */
@@ -144,6 +146,7 @@ public:
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h);
 	virtual Graphics::Surface *lockScreen();
 	virtual void unlockScreen();
+	virtual void unlockScreenRect(const Common::Rect &rect);
 	virtual void fillScreen(uint32 col);
 	virtual void updateScreen();
 	virtual void setShakePos(int shakeOffset);
@@ -212,6 +215,8 @@ protected:
 
 	/** Temporary screen (for scalers) */
 	sSDL_Surface *_tmpscreen;
+	/** _tmpscreen was bypassed and no longer matches _screen */
+	bool _tmpscreenStale;
 	/** Temporary screen (for scalers) */
 	SDL_Surface *_tmpscreen2;
 
@@ -276,6 +281,24 @@ protected:
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
+	/**
+	 * Time spent in the stages of internUpdateScreen(), in milliseconds,
+	 * summed over kUpdateStatsFrames updates and then logged at debug
+	 * level 2. Single updates are mostly shorter than the clock
+	 * resolution, so the sums are a sample rather than an exact count.
+	 */
+	struct UpdateStats {
+		uint32 frames;
+		uint32 convert;	///< Palette conversion into _tmpscreen
+		uint32 scale;	///< Scaling, including fused conversion, and aspect correction
+		uint32 overlay;	///< Mouse cursor, OSD and focus rectangle
+		uint32 present;	///< SDL_UpdateRects
+	};
+	enum {
+		kUpdateStatsFrames = 500
+	};
+	UpdateStats _updateStats;
+
 	struct MousePos {
 		// The mouse position, using either virtual (game) or real
 		// (overlay) coordinates.
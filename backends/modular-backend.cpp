@@ -136,6 +136,10 @@ void ModularBackend::unlockScreen() {
 	_graphicsManager->unlockScreen();
 }
 
+void ModularBackend::unlockScreenRect(const Common::Rect &rect) {
+	_graphicsManager->unlockScreenRect(rect);
+}
+
 void ModularBackend::fillScreen(uint32 col) {
 	_graphicsManager->fillScreen(col);
 }
@@ -46,6 +46,8 @@ static Common::String getSavePath() {
 //////////////////////////
 
 Common::OutSaveFile *GBAMPSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	++_changeCount;
+
 	Common::String fileSpec = getSavePath();
 	if (fileSpec.lastChar() != '/')
 		fileSpec += '/';
@@ -27,8 +27,13 @@
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "audio/mixer_intern.h"
+#include "common/EventRecorder.h"
 #include "common/scummsys.h"
 
+#if defined(POSIX)
+#include <sys/time.h>
+#endif
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -52,8 +57,16 @@ public:
 	virtual uint32 getMillis();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const {}
+	virtual void updateScreen();
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+private:
+	uint32 getRealMillis() const;
+
+#if defined(POSIX)
+	timeval _startTime;
+#endif
 };
 
 OSystem_NULL::OSystem_NULL() {
@@ -66,6 +79,10 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#if defined(POSIX)
+	gettimeofday(&_startTime, 0);
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -92,11 +109,32 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 	return false;
 }
 
-uint32 OSystem_NULL::getMillis() {
+uint32 OSystem_NULL::getRealMillis() const {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint32)((curTime.tv_sec - _startTime.tv_sec) * 1000 +
+			((curTime.tv_usec - _startTime.tv_usec) / 1000));
+#else
 	return 0;
+#endif
+}
+
+uint32 OSystem_NULL::getMillis() {
+	uint32 millis = getRealMillis();
+	g_eventRec.processMillis(millis);
+	return millis;
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	// There is nothing to wait for without a display, so never sleep
+	g_eventRec.processDelayMillis(msecs);
+}
+
+void OSystem_NULL::updateScreen() {
+	uint32 start = getRealMillis();
+	ModularBackend::updateScreen();
+	g_eventRec.processScreenUpdate(getRealMillis() - start);
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
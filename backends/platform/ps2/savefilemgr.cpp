@@ -146,6 +146,8 @@ Common::InSaveFile *Ps2SaveFileManager::openForLoading(const Common::String &fil
 }
 
 Common::OutSaveFile *Ps2SaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	++_changeCount;
+
 	Common::FSNode savePath(ConfMan.get("savepath")); // TODO: is this fast?
 	Common::WriteStream *sf;
 
@@ -197,6 +199,8 @@ Common::OutSaveFile *Ps2SaveFileManager::openForSaving(const Common::String &fil
 }
 
 bool Ps2SaveFileManager::removeSavefile(const Common::String &filename) {
+	++_changeCount;
+
 	Common::FSNode savePath(ConfMan.get("savepath")); // TODO: is this fast?
 	Common::FSNode file;
 
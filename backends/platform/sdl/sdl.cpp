@@ -477,6 +477,12 @@ void OSystem_SDL::delayMillis(uint msecs) {
 		SDL_Delay(msecs);
 }
 
+void OSystem_SDL::updateScreen() {
+	uint32 start = SDL_GetTicks();
+	ModularBackend::updateScreen();
+	g_eventRec.processScreenUpdate(SDL_GetTicks() - start);
+}
+
 void OSystem_SDL::getTimeAndDate(TimeDate &td) const {
 	time_t curTime = time(0);
 	struct tm t = *localtime(&curTime);
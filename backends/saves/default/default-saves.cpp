@@ -98,6 +98,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	++_changeCount;
+
 	// Ensure that the savepath is valid. If not, generate an appropriate error.
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
@@ -116,6 +118,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	++_changeCount;
+
 	Common::String savePathName = getSavePath();
 	checkPath(Common::FSNode(savePathName));
 	if (getError().getCode() != Common::kNoError)
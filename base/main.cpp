@@ -56,6 +56,8 @@
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
+#include "gui/ThemeCache.h"
+#include "gui/saveload-dialog.h"
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
@@ -555,6 +557,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
+	GUI::ThemeCache::destroy();
+	GUI::SaveStateCache::destroy();
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
 	Common::EventRecorder::destroy();
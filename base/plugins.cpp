@@ -22,9 +22,16 @@
 
 #include "base/plugins.h"
 
+#include "common/algorithm.h"
 #include "common/func.h"
 #include "common/debug.h"
 #include "common/config-manager.h"
+#include "common/md5.h"
+#include "common/savefile.h"
+#include "common/system.h"
+#include "common/tokenizer.h"
+
+#include "engines/metaengine.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
@@ -289,6 +296,14 @@ void PluginManagerUncached::init() {
  * gameId under the domain 'plugin_files'.
  **/
 bool PluginManagerUncached::loadPluginFromGameId(const Common::String &gameId) {
+	if (updateIndex()) {
+		for (PluginIndex::const_iterator i = _index.begin(); i != _index.end(); ++i) {
+			const Common::StringArray &gameIds = i->_value.gameIds;
+			if (Common::find(gameIds.begin(), gameIds.end(), gameId) != gameIds.end())
+				return loadPluginByFileName(i->_key);
+		}
+	}
+
 	Common::ConfigManager::Domain *domain = ConfMan.getDomain("plugin_files");
 
 	if (domain) {
@@ -341,26 +356,230 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &gameI
 	}
 }
 
+/**
+ * The plugin index records for each engine plugin file which games it
+ * supports and which files its detector looks for. It is stored as a save
+ * file and only refreshed for plugin files whose size or first bytes have
+ * changed, so that finding a game or detecting games in a directory only
+ * loads the plugins which can handle them.
+ **/
+static const char *const kPluginIndexFileName = "plugins.idx";
+static const char *const kPluginIndexHeader = "ScummVM plugin index 1";
+
+static Common::String getPluginStamp(const Common::String &filename) {
+	Common::SeekableReadStream *stream = Common::FSNode(filename).createReadStream();
+	if (!stream)
+		return Common::String();
+
+	Common::String stamp = Common::String::format("%d-%s", stream->size(), Common::computeStreamMD5AsString(*stream, 5000).c_str());
+	delete stream;
+	return stamp;
+}
+
+/**
+ * Bring the plugin index up to date, loading the plugins which are new
+ * or have changed since it was written. Returns false if the index can't
+ * be used, e.g. because the backend is not initialized yet.
+ **/
+bool PluginManagerUncached::updateIndex() {
+	if (_indexValid)
+		return true;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return false;
+
+	loadIndex(saveFileMan);
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, NULL, false);
+
+	PluginIndex index;
+	bool changed = false;
+
+	for (PluginList::iterator p = _allEnginePlugins.begin(); p != _allEnginePlugins.end(); ++p) {
+		if (!(*p)->getFileName())
+			continue;
+
+		const Common::String filename = (*p)->getFileName();
+		const Common::String stamp = getPluginStamp(filename);
+
+		PluginIndex::const_iterator old = _index.find(filename);
+		if (old != _index.end() && old->_value.stamp == stamp) {
+			index[filename] = old->_value;
+			continue;
+		}
+
+		changed = true;
+		if (!(*p)->loadPlugin())
+			continue;
+
+		debug(1, "Adding plugin '%s' to the plugin index", filename.c_str());
+
+		const MetaEngine &metaEngine = **(EnginePlugin *)*p;
+		IndexEntry &entry = index[filename];
+		entry.stamp = stamp;
+
+		GameList games = metaEngine.getSupportedGames();
+		for (GameList::const_iterator g = games.begin(); g != games.end(); ++g)
+			entry.gameIds.push_back(g->gameid());
+
+		entry.fileBased = metaEngine.getDetectionFileNames(entry.detectFiles);
+
+		(*p)->unloadPlugin();
+	}
+
+	// Drop the entries of plugin files which are gone
+	changed |= (index.size() != _index.size());
+
+	_index = index;
+	_indexValid = true;
+
+	if (changed)
+		saveIndex(saveFileMan);
+
+	return true;
+}
+
+void PluginManagerUncached::loadIndex(Common::SaveFileManager *saveFileMan) {
+	_index.clear();
+
+	Common::InSaveFile *in = saveFileMan->openForLoading(kPluginIndexFileName);
+	if (!in)
+		return;
+
+	if (in->readLine() != kPluginIndexHeader) {
+		delete in;
+		return;
+	}
+
+	IndexEntry *entry = 0;
+	while (!in->eos() && !in->err()) {
+		Common::StringTokenizer tokenizer(in->readLine(), "\t");
+		const Common::String type = tokenizer.nextToken();
+
+		if (type == "plugin") {
+			entry = &_index[tokenizer.nextToken()];
+			entry->stamp = tokenizer.nextToken();
+			entry->fileBased = false;
+		} else if (entry && type == "games") {
+			while (!tokenizer.empty())
+				entry->gameIds.push_back(tokenizer.nextToken());
+		} else if (entry && type == "files") {
+			entry->fileBased = true;
+			while (!tokenizer.empty())
+				entry->detectFiles.push_back(tokenizer.nextToken());
+		}
+	}
+
+	delete in;
+}
+
+void PluginManagerUncached::saveIndex(Common::SaveFileManager *saveFileMan) const {
+	Common::OutSaveFile *out = saveFileMan->openForSaving(kPluginIndexFileName, false);
+	if (!out) {
+		warning("Could not write the plugin index");
+		return;
+	}
+
+	out->writeString(kPluginIndexHeader);
+	out->writeByte('\n');
+
+	for (PluginIndex::const_iterator i = _index.begin(); i != _index.end(); ++i) {
+		const IndexEntry &entry = i->_value;
+
+		out->writeString("plugin\t" + i->_key + "\t" + entry.stamp + "\ngames");
+		for (uint j = 0; j < entry.gameIds.size(); ++j)
+			out->writeString("\t" + entry.gameIds[j]);
+		out->writeByte('\n');
+
+		if (entry.fileBased) {
+			out->writeString("files");
+			for (uint j = 0; j < entry.detectFiles.size(); ++j)
+				out->writeString("\t" + entry.detectFiles[j]);
+			out->writeByte('\n');
+		}
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Could not write the plugin index");
+	delete out;
+}
+
+/**
+ * Check with the plugin index whether a plugin may detect a game among the
+ * files passed to loadFirstPluginForDetection().
+ **/
+bool PluginManagerUncached::mayDetect(const Plugin *plugin) const {
+	if (!_filterDetection || !plugin->getFileName())
+		return true;
+
+	PluginIndex::const_iterator i = _index.find(plugin->getFileName());
+	if (i == _index.end() || !i->_value.fileBased)
+		return true;
+
+	const Common::StringArray &detectFiles = i->_value.detectFiles;
+	for (uint j = 0; j < detectFiles.size(); ++j) {
+		if (_detectFiles.contains(detectFiles[j]))
+			return true;
+	}
+	return false;
+}
+
+bool PluginManagerUncached::loadCurrentPlugin() {
+	if (!mayDetect(*_currentPlugin) || !(*_currentPlugin)->loadPlugin())
+		return false;
+
+	addToPluginsInMemList(*_currentPlugin);
+	return true;
+}
+
 void PluginManagerUncached::loadFirstPlugin() {
+	_filterDetection = false;
 	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, NULL, false);
 
 	// let's try to find one we can load
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
-		if ((*_currentPlugin)->loadPlugin()) {
-			addToPluginsInMemList(*_currentPlugin);
+		if (loadCurrentPlugin())
 			break;
+	}
+}
+
+/**
+ * Like loadFirstPlugin(), but skip the plugins which according to the
+ * plugin index can't detect a game among the given files.
+ **/
+void PluginManagerUncached::loadFirstPluginForDetection(const Common::FSList &fslist) {
+	_detectFiles.clear();
+	_filterDetection = updateIndex();
+
+	if (_filterDetection) {
+		for (Common::FSList::const_iterator file = fslist.begin(); file != fslist.end(); ++file) {
+			Common::String name = file->getName();
+
+			// Strip any trailing dot, as the advanced detector does
+			if (name.lastChar() == '.')
+				name.deleteLastChar();
+
+			_detectFiles[name] = true;
 		}
 	}
+
+	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, NULL, false);
+	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
+		if (loadCurrentPlugin())
+			break;
+	}
 }
 
 bool PluginManagerUncached::loadNextPlugin() {
 	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, NULL, false);
 
+	if (_currentPlugin == _allEnginePlugins.end())
+		return false;
+
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
-		if ((*_currentPlugin)->loadPlugin()) {
-			addToPluginsInMemList(*_currentPlugin);
+		if (loadCurrentPlugin())
 			return true;
-		}
 	}
 	return false;	// no more in list
 }
@@ -518,7 +737,7 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 	GameList candidates;
 	EnginePlugin::List plugins;
 	EnginePlugin::List::const_iterator iter;
-	PluginManager::instance().loadFirstPlugin();
+	PluginManager::instance().loadFirstPluginForDetection(fslist);
 	do {
 		plugins = getPlugins();
 		// Iterate over all known games and for each check if it might be
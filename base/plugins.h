@@ -25,9 +25,15 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
 #include "common/str.h"
+#include "common/str-array.h"
 #include "backends/plugins/elf/version.h"
 
+namespace Common {
+class SaveFileManager;
+}
+
 
 /**
  * @page pagePlugins An overview of the ScummVM plugin system
@@ -329,6 +335,7 @@ public:
 	// Functions used by the uncached PluginManager
 	virtual void init()	{}
 	virtual void loadFirstPlugin() {}
+	virtual void loadFirstPluginForDetection(const Common::FSList &fslist) {}
 	virtual bool loadNextPlugin() { return false; }
 	virtual bool loadPluginFromGameId(const Common::String &gameId) { return false; }
 	virtual void updateConfigWithFileName(const Common::String &gameId) {}
@@ -352,12 +359,37 @@ protected:
 	PluginList _allEnginePlugins;
 	PluginList::iterator _currentPlugin;
 
-	PluginManagerUncached() {}
+	/**
+	 * What the plugin index knows about an engine plugin file, so that
+	 * the plugin does not have to be loaded to find out.
+	 */
+	struct IndexEntry {
+		Common::String stamp;				///< Size and MD5 prefix of the plugin file
+		Common::StringArray gameIds;		///< Games supported by the engine
+		bool fileBased;						///< Whether detection needs one of detectFiles
+		Common::StringArray detectFiles;	///< See MetaEngine::getDetectionFileNames()
+	};
+	typedef Common::HashMap<Common::String, IndexEntry> PluginIndex;	///< Keyed by plugin file name
+	typedef Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileNameSet;
+
+	PluginIndex _index;
+	bool _indexValid;
+	FileNameSet _detectFiles;
+	bool _filterDetection;
+
+	PluginManagerUncached() : _indexValid(false), _filterDetection(false) {}
 	bool loadPluginByFileName(const Common::String &filename);
+	bool loadCurrentPlugin();
+
+	bool updateIndex();
+	void loadIndex(Common::SaveFileManager *saveFileMan);
+	void saveIndex(Common::SaveFileManager *saveFileMan) const;
+	bool mayDetect(const Plugin *plugin) const;
 
 public:
 	virtual void init();
 	virtual void loadFirstPlugin();
+	virtual void loadFirstPluginForDetection(const Common::FSList &fslist);
 	virtual bool loadNextPlugin();
 	virtual bool loadPluginFromGameId(const Common::String &gameId);
 	virtual void updateConfigWithFileName(const Common::String &gameId);
@@ -28,6 +28,8 @@
 #include "common/savefile.h"
 #include "common/textconsole.h"
 
+#include "graphics/surface.h"
+
 namespace Common {
 
 DECLARE_SINGLETON(EventRecorder);
@@ -130,6 +132,14 @@ EventRecorder::EventRecorder() {
 	_lastEventMillis = 0;
 
 	_recordMode = kPassthrough;
+
+	_benchmark = false;
+	_benchmarkDone = false;
+	_benchmarkStart = 0;
+	_benchmarkGameTime = 0;
+	_benchmarkFrames = 0;
+	_benchmarkPresentTime = 0;
+	_benchmarkSkippedDelay = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -141,6 +151,12 @@ EventRecorder::~EventRecorder() {
 
 void EventRecorder::init() {
 	String recordModeString = ConfMan.get("record_mode");
+	_benchmark = false;
+	_benchmarkDone = false;
+	_benchmarkGameTime = 0;
+	_benchmarkFrames = 0;
+	_benchmarkPresentTime = 0;
+	_benchmarkSkippedDelay = 0;
 	if (recordModeString.compareToIgnoreCase("record") == 0) {
 		_recordMode = kRecorderRecord;
 
@@ -149,6 +165,11 @@ void EventRecorder::init() {
 		if (recordModeString.compareToIgnoreCase("playback") == 0) {
 			_recordMode = kRecorderPlayback;
 			debug(3, "EventRecorder: playback");
+		} else if (recordModeString.compareToIgnoreCase("benchmark") == 0) {
+			// Same as playback, but never wait for the recorded timeline
+			_recordMode = kRecorderPlayback;
+			_benchmark = true;
+			debug(3, "EventRecorder: benchmark");
 		} else {
 			_recordMode = kPassthrough;
 			debug(3, "EventRecorder: passthrough");
@@ -224,6 +245,9 @@ void EventRecorder::init() {
 		}
 
 		_hasPlaybackEvent = false;
+
+		if (_benchmark)
+			_benchmarkStart = getRealMillis();
 	}
 
 	g_system->getEventManager()->getEventDispatcher()->registerSource(this, false);
@@ -233,6 +257,9 @@ void EventRecorder::init() {
 void EventRecorder::deinit() {
 	debug(3, "EventRecorder: deinit");
 
+	if (isBenchmarking())
+		reportBenchmark(false);
+
 	g_system->getEventManager()->getEventDispatcher()->unregisterSource(this);
 	g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
@@ -325,7 +352,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 		if (_recordTimeCount > _playbackTimeCount) {
 			d = readTime(_playbackTimeFile);
 
-			while ((_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
+			while (!_benchmark && (_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
 				_recordMode = kPassthrough;
 				g_system->delayMillis(50);
 				millis = g_system->getMillis();
@@ -334,6 +361,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 			millis = _lastMillis + d;
 			_playbackTimeCount++;
+			_benchmarkGameTime = millis;
 		}
 	}
 
@@ -342,6 +370,13 @@ void EventRecorder::processMillis(uint32 &millis) {
 }
 
 bool EventRecorder::processDelayMillis(uint &msecs) {
+	// The recorded timeline already defines what getMillis() returns, so
+	// a benchmark run never has to actually sleep.
+	if (isBenchmarking()) {
+		_benchmarkSkippedDelay += msecs;
+		return true;
+	}
+
 	if (_recordMode == kRecorderPlayback) {
 		_recordMode = kPassthrough;
 
@@ -422,7 +457,80 @@ bool EventRecorder::pollEvent(Event &ev) {
 		}
 	}
 
+	if (_benchmark && !_benchmarkDone && _playbackCount >= _recordCount && _playbackTimeCount >= _recordTimeCount) {
+		// The whole recording was consumed, end the benchmark run
+		reportBenchmark(true);
+		ev.type = EVENT_QUIT;
+		return true;
+	}
+
 	return false;
 }
 
+uint32 EventRecorder::getRealMillis() {
+	RecordMode mode = _recordMode;
+	_recordMode = kPassthrough;
+	uint32 millis = g_system->getMillis();
+	_recordMode = mode;
+
+	return millis;
+}
+
+void EventRecorder::processScreenUpdate(uint32 presentTime) {
+	if (isBenchmarking()) {
+		++_benchmarkFrames;
+		_benchmarkPresentTime += presentTime;
+	}
+}
+
+uint32 EventRecorder::checksumScreen() {
+	Graphics::Surface *screen = g_system->lockScreen();
+	if (!screen)
+		return 0;
+
+	// Adler-32 of the visible pixels, skipping the padding of each row
+	uint32 a = 1, b = 0;
+	for (int y = 0; y < screen->h; ++y) {
+		const byte *pixels = (const byte *)screen->getBasePtr(0, y);
+		for (int x = 0; x < screen->w * screen->format.bytesPerPixel; ++x) {
+			a = (a + pixels[x]) % 65521;
+			b = (b + a) % 65521;
+		}
+	}
+
+	g_system->unlockScreen();
+	return (b << 16) | a;
+}
+
+void EventRecorder::reportBenchmark(bool finished) {
+	if (_benchmarkDone)
+		return;
+	_benchmarkDone = true;
+
+	uint32 wallTime = getRealMillis() - _benchmarkStart;
+	uint32 gameTime = _benchmarkGameTime;
+
+	debug("EventRecorder: benchmark played %d of %d events and %d of %d time records",
+	      _playbackCount, _recordCount, _playbackTimeCount, _recordTimeCount);
+	if (wallTime > 0) {
+		debug("EventRecorder: benchmark ran %d ms of game time in %d ms (%d.%02dx realtime)",
+		      gameTime, wallTime, gameTime / wallTime, (gameTime % wallTime) * 100 / wallTime);
+		debug("EventRecorder: benchmark drew %d frames (%d.%02d fps)",
+		      _benchmarkFrames, _benchmarkFrames * 1000 / wallTime, (_benchmarkFrames * 1000 % wallTime) * 100 / wallTime);
+		// Only the backend's frame presentation is timed separately; script,
+		// decoding, audio mixing on the main thread and file I/O all fall
+		// into the engine share.
+		uint32 presentTime = MIN(_benchmarkPresentTime, wallTime);
+		debug("EventRecorder: benchmark spent %d ms presenting frames and %d ms in the engine, skipped %d ms of delays",
+		      presentTime, wallTime - presentTime, _benchmarkSkippedDelay);
+	} else {
+		debug("EventRecorder: benchmark ran %d ms of game time in less than 1 ms", gameTime);
+	}
+
+	// The final screen is only comparable between runs which played the
+	// whole recording
+	if (finished)
+		debug("EventRecorder: benchmark final frame checksum %08x", checksumScreen());
+}
+
 } // End of namespace Common
@@ -59,12 +59,31 @@ public:
 	/** TODO: Add documentation, this is only used by the backend */
 	bool processDelayMillis(uint &msecs);
 
+	/**
+	 * Count a screen update for the benchmark summary, called by the backend
+	 * with the host time it spent presenting the frame.
+	 */
+	void processScreenUpdate(uint32 presentTime);
+
+	/** Is a recording being played back as fast as possible? */
+	bool isBenchmarking() const { return _recordMode == kRecorderPlayback && _benchmark; }
+
 private:
 	bool notifyEvent(const Event &ev);
 	bool notifyPoll();
 	bool pollEvent(Event &ev);
 	bool allowMapping() const { return false; }
 
+	/** Return the host time, bypassing the recorded timeline. */
+	uint32 getRealMillis();
+	/** Return a checksum of the pixels currently on screen. */
+	uint32 checksumScreen();
+	/**
+	 * Print the summary of a benchmark run.
+	 * @param finished  whether the whole recording was played back
+	 */
+	void reportBenchmark(bool finished);
+
 	class RandomSourceRecord {
 	public:
 		String name;
@@ -100,6 +119,14 @@ private:
 		kRecorderPlayback = 2
 	};
 	volatile RecordMode _recordMode;
+
+	bool _benchmark;        ///< Play back without waiting for the recorded timeline
+	bool _benchmarkDone;    ///< Benchmark summary was already printed
+	uint32 _benchmarkStart; ///< Host time when playback started
+	uint32 _benchmarkGameTime; ///< Last time stamp replayed from the recording
+	uint32 _benchmarkFrames; ///< Screen updates since playback started
+	uint32 _benchmarkPresentTime; ///< Host time spent in the backend's updateScreen
+	uint32 _benchmarkSkippedDelay; ///< Delays requested by the engine which were not slept
 	String _recordFileName;
 	String _recordTempFileName;
 	String _recordTimeFileName;
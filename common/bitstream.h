@@ -26,6 +26,7 @@
 #define COMMON_BITSTREAM_H
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 #include "common/textconsole.h"
 #include "common/stream.h"
 
@@ -320,6 +321,237 @@ typedef BitStreamImpl<32, false, true > BitStream32BEMSB;
 /** 32-bit big-endian data, LSB to MSB. */
 typedef BitStreamImpl<32, false, false> BitStream32BELSB;
 
+/**
+ * A bit stream reading directly from a memory buffer.
+ *
+ * It uses the same layout parameters and bit order as BitStreamImpl, but
+ * is not derived from BitStream. All methods are non-virtual and can be
+ * inlined into the decoder loops, and the data is fetched into a 64-bit
+ * cache a whole value at a time instead of bit by bit from a stream.
+ *
+ * Reading past the end of the buffer is an error, just like with
+ * BitStreamImpl. Peeking past the end returns zero bits instead, so that
+ * table driven decoders can always peek a full table index.
+ *
+ * The buffer is not copied and has to stay valid while the bit stream
+ * is in use.
+ */
+template<int valueBits, bool isLE, bool isMSB2LSB>
+class BitStreamMemory {
+public:
+	/** Bit order, for decoders specialized on it. */
+	static const bool kMSB2LSB = isMSB2LSB;
+
+private:
+	const byte *_data; ///< Start of the buffer.
+	const byte *_ptr;  ///< Next value to load into the cache.
+	const byte *_end;  ///< End of the last complete value in the buffer.
+
+	uint64 _cache;     ///< Buffered bits, next bit first.
+	uint32 _cacheBits; ///< Number of bits in the cache.
+
+	uint32 _pos;       ///< Position in bits.
+	uint32 _size;      ///< Size in bits.
+
+	/** Read the next data value, or 0 past the end of the buffer. */
+	inline uint32 readValue() {
+		if (_ptr >= _end)
+			return 0;
+
+		uint32 v;
+		if (valueBits == 8)
+			v = *_ptr;
+		else if (valueBits == 16)
+			v = isLE ? READ_LE_UINT16(_ptr) : READ_BE_UINT16(_ptr);
+		else
+			v = isLE ? READ_LE_UINT32(_ptr) : READ_BE_UINT32(_ptr);
+
+		_ptr += valueBits >> 3;
+		return v;
+	}
+
+	/** Fill the cache with as many whole values as fit. */
+	inline void refill() {
+		while (_cacheBits <= 64 - valueBits) {
+			uint64 v = readValue();
+
+			if (isMSB2LSB)
+				_cache |= v << (64 - valueBits - _cacheBits);
+			else
+				_cache |= v << _cacheBits;
+
+			_cacheBits += valueBits;
+		}
+	}
+
+	/** Return the next n (1 to 32) bits in the cache. */
+	inline uint32 peekCache(uint8 n) const {
+		if (isMSB2LSB)
+			return (uint32)(_cache >> (64 - n));
+		else
+			return (uint32)_cache & (0xFFFFFFFF >> (32 - n));
+	}
+
+	/** Drop n (less than 64) bits from the cache. */
+	inline void consume(uint32 n) {
+		if (isMSB2LSB)
+			_cache <<= n;
+		else
+			_cache >>= n;
+
+		_cacheBits -= n;
+		_pos += n;
+	}
+
+	/** Move to any bit position. */
+	void seekBits(uint32 pos) {
+		_ptr = _data + (pos / valueBits) * (valueBits >> 3);
+		_pos = pos - (pos % valueBits);
+
+		_cache = 0;
+		_cacheBits = 0;
+
+		refill();
+		consume(pos % valueBits);
+	}
+
+public:
+	/** Create a bit stream reading from this buffer of size bytes. */
+	BitStreamMemory(const byte *data, uint32 size) : _data(data) {
+		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
+			error("BitStreamMemory: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+
+		size &= ~((uint32) ((valueBits >> 3) - 1));
+
+		_end  = data + size;
+		_size = size * 8;
+
+		seekBits(0);
+	}
+
+	/** Read a bit from the bit stream. */
+	inline uint32 getBit() {
+		return getBits(1);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream.
+	 *
+	 * The bit order is the same as in BitStreamImpl::getBits().
+	 */
+	inline uint32 getBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemory::getBits(): Too many bits requested to be read");
+
+		if (_pos + n > _size)
+			error("BitStreamMemory::getBits(): End of bit stream reached");
+
+		if (_cacheBits < n)
+			refill();
+
+		uint32 v = peekCache(n);
+		consume(n);
+		return v;
+	}
+
+	/** Read a bit from the bit stream, without changing the stream's position. */
+	inline uint32 peekBit() {
+		return peekBits(1);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream, without changing the stream's position.
+	 *
+	 * The bit order is the same as in getBits(). Bits past the end of the
+	 * stream read as 0.
+	 */
+	inline uint32 peekBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemory::peekBits(): Too many bits requested to be read");
+
+		if (_cacheBits < n)
+			refill();
+
+		return peekCache(n);
+	}
+
+	/**
+	 * Add a bit to the value x, making it an n+1-bit value.
+	 *
+	 * See BitStreamImpl::addBit().
+	 */
+	inline void addBit(uint32 &x, uint32 n) {
+		if (n >= 32)
+			error("BitStreamMemory::addBit(): Too many bits requested to be read");
+
+		if (isMSB2LSB)
+			x = (x << 1) | getBit();
+		else
+			x = (x & ~(1 << n)) | (getBit() << n);
+	}
+
+	/** Rewind the bit stream back to the start. */
+	void rewind() {
+		seekBits(0);
+	}
+
+	/** Skip the specified amount of bits. */
+	inline void skip(uint32 n) {
+		if (_pos + n > _size)
+			error("BitStreamMemory::skip(): End of bit stream reached");
+
+		if (n < _cacheBits)
+			consume(n);
+		else
+			seekBits(_pos + n);
+	}
+
+	/** Return the stream position in bits. */
+	uint32 pos() const {
+		return _pos;
+	}
+
+	/** Return the stream size in bits. */
+	uint32 size() const {
+		return _size;
+	}
+
+	bool eos() const {
+		return _pos >= _size;
+	}
+};
+
+// typedefs for various memory layouts.
+
+/** 8-bit data, MSB to LSB. */
+typedef BitStreamMemory<8, false, true > BitStreamMemory8MSB;
+/** 8-bit data, LSB to MSB. */
+typedef BitStreamMemory<8, false, false> BitStreamMemory8LSB;
+
+/** 16-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemory<16, true , true > BitStreamMemory16LEMSB;
+/** 16-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemory<16, true , false> BitStreamMemory16LELSB;
+/** 16-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemory<16, false, true > BitStreamMemory16BEMSB;
+/** 16-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemory<16, false, false> BitStreamMemory16BELSB;
+
+/** 32-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemory<32, true , true > BitStreamMemory32LEMSB;
+/** 32-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemory<32, true , false> BitStreamMemory32LELSB;
+/** 32-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemory<32, false, true > BitStreamMemory32BEMSB;
+/** 32-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemory<32, false, false> BitStreamMemory32BELSB;
+
 } // End of namespace Common
 
 #endif // COMMON_BITSTREAM_H
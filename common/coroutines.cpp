@@ -71,6 +71,77 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+
+enum {
+	/** Context sizes are rounded up to a multiple of this */
+	kContextSizeGranularity = 16,
+	/** Number of size classes; larger contexts aren't pooled */
+	kContextSizeClasses = 16
+};
+
+/** A freed context waiting for reuse */
+struct FreeContext {
+	FreeContext *next;
+};
+
+static FreeContext *s_freeContexts[kContextSizeClasses];
+
+#ifdef DEBUG
+static int s_contextAllocs = 0;
+static int s_contextReuses = 0;
+#endif
+
+} // End of anonymous namespace
+
+void *CoroBaseContext::operator new(size_t size) {
+	const size_t sizeClass = (size - 1) / kContextSizeGranularity;
+
+	if (sizeClass >= kContextSizeClasses)
+		return malloc(size);
+
+#ifdef DEBUG
+	s_contextAllocs++;
+#endif
+
+	FreeContext *ctx = s_freeContexts[sizeClass];
+	if (ctx) {
+#ifdef DEBUG
+		s_contextReuses++;
+#endif
+		s_freeContexts[sizeClass] = ctx->next;
+		return ctx;
+	}
+
+	return malloc((sizeClass + 1) * kContextSizeGranularity);
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	const size_t sizeClass = (size - 1) / kContextSizeGranularity;
+
+	if (sizeClass >= kContextSizeClasses) {
+		free(ptr);
+		return;
+	}
+
+	FreeContext *ctx = (FreeContext *)ptr;
+	ctx->next = s_freeContexts[sizeClass];
+	s_freeContexts[sizeClass] = ctx;
+}
+
+void CoroBaseContext::freeContextPool() {
+	for (int i = 0; i < kContextSizeClasses; i++) {
+		while (s_freeContexts[i]) {
+			FreeContext *next = s_freeContexts[i]->next;
+			free(s_freeContexts[i]);
+			s_freeContexts[i] = next;
+		}
+	}
+}
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(0) {
 #ifdef COROUTINE_DEBUG
@@ -130,9 +201,10 @@ CoroutineScheduler::~CoroutineScheduler() {
 	active = 0;
 
 	// Clear the event list
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i)
-		delete *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i)
+		delete i->_value;
+
+	CoroBaseContext::freeContextPool();
 }
 
 void CoroutineScheduler::reset() {
@@ -165,6 +237,7 @@ void CoroutineScheduler::reset() {
 
 	// no active processes
 	pCurrent = active->pNext = NULL;
+	_pidCounts.clear();
 
 	// place first process on free list
 	pFreeProcesses = processList;
@@ -180,6 +253,7 @@ void CoroutineScheduler::reset() {
 #ifdef DEBUG
 void CoroutineScheduler::printStats() {
 	debug("%i process of %i used", maxProcs, CORO_NUM_PROCESS);
+	debug("%i coroutine contexts allocated, %i of them reused", s_contextAllocs, s_contextReuses);
 }
 #endif
 
@@ -247,9 +321,8 @@ void CoroutineScheduler::schedule() {
 	}
 
 	// Disable any events that were pulsed
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
+	for (EventMap::iterator i = _events.begin(); i != _events.end(); ++i) {
+		EVENT *evt = i->_value;
 		if (evt->pulsing) {
 			evt->pulsing = evt->signalled = false;
 		}
@@ -347,7 +420,7 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 
 	CORO_BEGIN_CONTEXT;
 		uint32 endTime;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -364,12 +437,12 @@ void CoroutineScheduler::waitForSingleObject(CORO_PARAM, int pid, uint32 duratio
 	// Outer loop for doing checks until expiry
 	while (g_system->getMillis() <= _ctx->endTime) {
 		// Check to see if a process or event with the given Id exists
-		_ctx->pProcess = getProcess(pid);
-		_ctx->pEvent = !_ctx->pProcess ? getEvent(pid) : NULL;
+		_ctx->processActive = isProcessActive(pid);
+		_ctx->pEvent = !_ctx->processActive ? getEvent(pid) : NULL;
 
 		// If there's no active process or event, presume it's a process that's finished,
 		// so the waiting can immediately exit
-		if ((_ctx->pProcess == NULL) && (_ctx->pEvent == NULL)) {
+		if (!_ctx->processActive && (_ctx->pEvent == NULL)) {
 			if (expired)
 				*expired = false;
 			break;
@@ -407,7 +480,7 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		bool signalled;
 		bool pidSignalled;
 		int i;
-		PROCESS *pProcess;
+		bool processActive;
 		EVENT *pEvent;
 	CORO_END_CONTEXT(_ctx);
 
@@ -427,11 +500,11 @@ void CoroutineScheduler::waitForMultipleObjects(CORO_PARAM, int nCount, uint32 *
 		_ctx->signalled = bWaitAll;
 
 		for (_ctx->i = 0; _ctx->i < nCount; ++_ctx->i) {
-			_ctx->pProcess = getProcess(pidList[_ctx->i]);
-			_ctx->pEvent = !_ctx->pProcess ? getEvent(pidList[_ctx->i]) : NULL;
+			_ctx->processActive = isProcessActive(pidList[_ctx->i]);
+			_ctx->pEvent = !_ctx->processActive ? getEvent(pidList[_ctx->i]) : NULL;
 
 			// Determine the signalled state
-			_ctx->pidSignalled = (_ctx->pProcess) || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
+			_ctx->pidSignalled = _ctx->processActive || !_ctx->pEvent ? false : _ctx->pEvent->signalled;
 
 			if (bWaitAll && !_ctx->pidSignalled)
 				_ctx->signalled = false;
@@ -538,6 +611,7 @@ PROCESS *CoroutineScheduler::createProcess(uint32 pid, CORO_ADDR coroAddr, const
 
 	// set new process id
 	pProc->pid = pid;
+	_pidCounts[pid]++;
 
 	// set new process specific info
 	if (sizeParam) {
@@ -580,6 +654,8 @@ void CoroutineScheduler::killProcess(PROCESS *pKillProc) {
 	delete pKillProc->state;
 	pKillProc->state = 0;
 
+	unindexProcess(pKillProc);
+
 	// Take the process out of the active chain list
 	pKillProc->pPrevious->pNext = pKillProc->pNext;
 	if (pKillProc->pNext)
@@ -629,6 +705,8 @@ int CoroutineScheduler::killMatchingProcess(uint32 pidKill, int pidMask) {
 				delete pProc->state;
 				pProc->state = 0;
 
+				unindexProcess(pProc);
+
 				// make prev point to next to unlink pProc
 				pPrev->pNext = pProc->pNext;
 				if (pProc->pNext)
@@ -662,23 +740,20 @@ void CoroutineScheduler::setResourceCallback(VFPTRPP pFunc) {
 	pRCfunction = pFunc;
 }
 
-PROCESS *CoroutineScheduler::getProcess(uint32 pid) {
-	PROCESS *pProc = active->pNext;
-	while ((pProc != NULL) && (pProc->pid != pid))
-		pProc = pProc->pNext;
+bool CoroutineScheduler::isProcessActive(uint32 pid) const {
+	return _pidCounts.contains(pid);
+}
 
-	return pProc;
+void CoroutineScheduler::unindexProcess(PROCESS *pProc) {
+	PidCountMap::iterator i = _pidCounts.find(pProc->pid);
+	assert(i != _pidCounts.end());
+
+	if (--i->_value == 0)
+		_pidCounts.erase(i);
 }
 
 EVENT *CoroutineScheduler::getEvent(uint32 pid) {
-	Common::List<EVENT *>::iterator i;
-	for (i = _events.begin(); i != _events.end(); ++i) {
-		EVENT *evt = *i;
-		if (evt->pid == pid)
-			return evt;
-	}
-
-	return NULL;
+	return _events.getVal(pid, NULL);
 }
 
 
@@ -689,14 +764,14 @@ uint32 CoroutineScheduler::createEvent(bool bManualReset, bool bInitialState) {
 	evt->signalled = bInitialState;
 	evt->pulsing = false;
 
-	_events.push_back(evt);
+	_events[evt->pid] = evt;
 	return evt->pid;
 }
 
 void CoroutineScheduler::closeEvent(uint32 pidEvent) {
 	EVENT *evt = getEvent(pidEvent);
 	if (evt) {
-		_events.remove(evt);
+		_events.erase(pidEvent);
 		delete evt;
 	}
 }
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/util.h"    // for SCUMMVM_CURRENT_FUNCTION
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/singleton.h"
 
@@ -65,6 +66,18 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts are allocated from per-size free lists, since coroutines
+	 * are entered and left very often.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
+
+	/**
+	 * Releases the memory of all contexts kept for reuse
+	 */
+	static void freeContextPool();
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -357,8 +370,13 @@ private:
 	/** Auto-incrementing process Id */
 	int pidCounter;
 
-	/** Event list */
-	Common::List<EVENT *> _events;
+	/** Events, indexed by their Id */
+	typedef Common::HashMap<uint32, EVENT *> EventMap;
+	EventMap _events;
+
+	/** Number of active processes with each process Id */
+	typedef Common::HashMap<uint32, uint> PidCountMap;
+	PidCountMap _pidCounts;
 
 #ifdef DEBUG
 	// diagnostic process counters
@@ -378,8 +396,12 @@ private:
 	 */
 	VFPTRPP pRCfunction;
 
-	PROCESS *getProcess(uint32 pid);
+	/** Returns whether any active process has the given Id */
+	bool isProcessActive(uint32 pid) const;
 	EVENT *getEvent(uint32 pid);
+
+	/** Removes a process about to be freed from the process Id index */
+	void unindexProcess(PROCESS *pProc);
 public:
 	/**
 	 * Kills all processes and places them on the free list.
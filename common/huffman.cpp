@@ -45,6 +45,9 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 
 	assert(maxLength <= 32);
 
+	_maxLength = maxLength;
+	_prefixBits = MIN<uint8>(maxLength, kPrefixBits);
+
 	_codes.resize(maxLength);
 	_symbols.resize(codeCount);
 
@@ -58,6 +61,8 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 		// And put the pointer to the symbol/code struct into the symbol list.
 		_symbols[i] = &_codes[lengths[i] - 1].back();
 	}
+
+	buildPrefixTables();
 }
 
 Huffman::~Huffman() {
@@ -66,6 +71,60 @@ Huffman::~Huffman() {
 void Huffman::setSymbols(const uint32 *symbols) {
 	for (uint32 i = 0; i < _symbols.size(); i++)
 		_symbols[i]->symbol = symbols ? *symbols++ : i;
+
+	buildPrefixTables();
+}
+
+void Huffman::buildPrefixTables() {
+	const uint32 tableSize = 1 << _prefixBits;
+
+	PrefixEntry empty;
+	empty.symbol = 0;
+	empty.length = 0;
+
+	_prefixMSB.resize(tableSize);
+	_prefixLSB.resize(tableSize);
+	for (uint32 i = 0; i < tableSize; i++)
+		_prefixMSB[i] = _prefixLSB[i] = empty;
+
+	// Every code fills all entries starting with it. With MSB first bit
+	// order the code is in the top bits of the index, otherwise in the
+	// bottom ones. Shorter codes are entered last, so that they win over
+	// longer ones should the codes not be prefix free.
+	for (int length = _prefixBits; length > 0; length--) {
+		const uint32 fill = 1 << (_prefixBits - length);
+
+		for (CodeList::const_iterator cCode = _codes[length - 1].begin(); cCode != _codes[length - 1].end(); ++cCode) {
+			// Such a code could never be read
+			if (cCode->code >> length)
+				continue;
+
+			PrefixEntry entry;
+			entry.symbol = cCode->symbol;
+			entry.length = length;
+
+			for (uint32 i = 0; i < fill; i++) {
+				_prefixMSB[(cCode->code << (_prefixBits - length)) | i] = entry;
+				_prefixLSB[cCode->code | (i << length)] = entry;
+			}
+		}
+	}
+}
+
+uint32 Huffman::getLongSymbol(uint32 bits, bool msb2lsb, uint8 &length) const {
+	for (uint32 i = _prefixBits; i < _codes.size(); i++) {
+		const uint32 code = msb2lsb ? (bits >> (_maxLength - i - 1)) : (bits & (0xFFFFFFFF >> (31 - i)));
+
+		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode) {
+			if (code == cCode->code) {
+				length = i + 1;
+				return cCode->symbol;
+			}
+		}
+	}
+
+	error("Unknown Huffman code");
+	return 0;
 }
 
 uint32 Huffman::getSymbol(BitStream &bits) const {
@@ -33,6 +33,9 @@ namespace Common {
 
 class BitStream;
 
+template<int valueBits, bool isLE, bool isMSB2LSB>
+class BitStreamMemory;
+
 /**
  * Huffman bitstream decoding
  *
@@ -58,7 +61,32 @@ public:
 	/** Return the next symbol in the bitstream. */
 	uint32 getSymbol(BitStream &bits) const;
 
+	/**
+	 * Return the next symbol in a BitStreamMemory.
+	 *
+	 * Codes of up to kPrefixBits bits are decoded with a single lookup
+	 * of the peeked bits in a prefix table. Only longer codes fall back
+	 * to searching the code lists.
+	 */
+	template<int valueBits, bool isLE, bool isMSB2LSB>
+	uint32 getSymbol(BitStreamMemory<valueBits, isLE, isMSB2LSB> &bits) const {
+		const PrefixEntry &entry = (isMSB2LSB ? _prefixMSB : _prefixLSB)[bits.peekBits(_prefixBits)];
+		if (entry.length) {
+			bits.skip(entry.length);
+			return entry.symbol;
+		}
+
+		uint8 length;
+		uint32 symbol = getLongSymbol(bits.peekBits(_maxLength), isMSB2LSB, length);
+		bits.skip(length);
+		return symbol;
+	}
+
 private:
+	enum {
+		kPrefixBits = 9 ///< Maximal number of bits looked up in the prefix tables
+	};
+
 	struct Symbol {
 		uint32 code;
 		uint32 symbol;
@@ -66,6 +94,11 @@ private:
 		Symbol(uint32 c, uint32 s);
 	};
 
+	struct PrefixEntry {
+		uint32 symbol;
+		uint8  length; ///< 0 if the code is longer than the prefix
+	};
+
 	typedef List<Symbol> CodeList;
 	typedef Array<CodeList> CodeLists;
 	typedef Array<Symbol *> SymbolList;
@@ -75,6 +108,18 @@ private:
 
 	/** Sorted list of pointers to the symbols. */
 	SymbolList _symbols;
+
+	uint8 _maxLength;
+	uint8 _prefixBits;
+
+	/** Codes by their first _prefixBits bits, for either bit order. */
+	Array<PrefixEntry> _prefixMSB;
+	Array<PrefixEntry> _prefixLSB;
+
+	void buildPrefixTables();
+
+	/** Find a code longer than the prefix among the next _maxLength bits. */
+	uint32 getLongSymbol(uint32 bits, bool msb2lsb, uint8 &length) const;
 };
 
 } // End of namespace Common
@@ -135,7 +135,10 @@ private:
 
 		byte *old_data = _data;
 
+		// Grow geometrically, so that writing many small pieces stays linear
 		_capacity = new_len + 32;
+		if (_capacity < 2 * _size)
+			_capacity = 2 * _size;
 		_data = (byte *)malloc(_capacity);
 		_ptr = _data + _pos;
 
@@ -73,7 +73,14 @@ protected:
 	 */
 	virtual void setError(Error error, const String &errorDesc) { _error = error; _errorDesc = errorDesc; }
 
+	/**
+	 * Number of times a savefile was opened for saving or removed. Has to be
+	 * increased by implementations of openForSaving and removeSavefile.
+	 */
+	uint32 _changeCount;
+
 public:
+	SaveFileManager() : _changeCount(0) {}
 	virtual ~SaveFileManager() {}
 
 	/**
@@ -103,6 +110,15 @@ public:
 	 */
 	virtual String popErrorDesc();
 
+	/**
+	 * Returns a counter which changes whenever a savefile is opened for
+	 * saving or removed. Code which caches information read from savefiles
+	 * can use it to tell whether that information might be outdated.
+	 *
+	 * @return the current change count.
+	 */
+	uint32 getChangeCount() const { return _changeCount; }
+
 	/**
 	 * Open the savefile with the specified name in the given directory for
 	 * saving.
@@ -314,7 +314,19 @@ public:
 		 *
 		 * This feature has no associated state.
 		 */
-		kFeatureDisplayLogFile
+		kFeatureDisplayLogFile,
+
+		/**
+		 * A backend has this feature if the surface returned by lockScreen()
+		 * is the one its screen updates are rendered from, so that drawing
+		 * into it and calling unlockScreenRect() costs no more than a
+		 * copyRectToScreen() call. Engines which compose their frames in a
+		 * buffer of their own can then compose them straight into the
+		 * screen instead, and save copying every changed pixel once more.
+		 *
+		 * This feature has no associated state.
+		 */
+		kFeatureDirectScreenAccess
 	};
 
 	/**
@@ -683,6 +695,15 @@ public:
 	 */
 	virtual void unlockScreen() = 0;
 
+	/**
+	 * Unlock the screen framebuffer, and only mark the given rectangle as
+	 * dirty. Backends which do not track dirty rectangles may update the
+	 * whole screen, which is also what the default implementation does.
+	 *
+	 * @see kFeatureDirectScreenAccess
+	 */
+	virtual void unlockScreenRect(const Common::Rect &rect) { unlockScreen(); }
+
 	/**
 	 * Fills the screen with a given color value.
 	 *
@@ -16,7 +16,7 @@ DEVTOOLS := \
 
 include $(srcdir)/devtools/*/module.mk
 
-.PHONY: $(srcdir)/devtools/*/module.mk
+.PHONY: $(srcdir)/devtools/*/module.mk scalerbench
 
 # Make sure the 'all' / 'clean' targets build/clean the devtools, too
 #all:
@@ -26,7 +26,7 @@ clean: clean-devtools
 devtools: $(DEVTOOLS)
 
 clean-devtools:
-	-$(RM) $(DEVTOOLS)
+	-$(RM) $(DEVTOOLS) devtools/scalerbench$(EXEEXT)
 
 #
 # Build rules for the devtools
@@ -44,6 +44,27 @@ devtools/make-scumm-fontdata$(EXEEXT): $(srcdir)/devtools/make-scumm-fontdata.c
 	$(QUIET)$(MKDIR) devtools/$(DEPDIR)
 	$(QUIET_LINK)$(LD) $(CFLAGS) -Wall -o $@ $<
 
+#
+# Scaler benchmark. Unlike the other devtools it is linked against the
+# graphics and common libraries, so that it measures the scalers exactly
+# as they are built for ScummVM. That is only possible in native builds:
+# emscripten builds (CXX is em++) produce a web page which the host
+# cannot run, and their libraries cannot be linked with a host compiler.
+#
+
+ifeq ($(findstring em++,$(CXX)),)
+scalerbench: devtools/scalerbench$(EXEEXT)
+	devtools/scalerbench$(EXEEXT)
+
+devtools/scalerbench$(EXEEXT): $(srcdir)/devtools/scalerbench.cpp graphics/libgraphics.a common/libcommon.a
+	$(QUIET)$(MKDIR) devtools/$(DEPDIR)
+	$(QUIET_LINK)$(CXX) $(CXXFLAGS) $(CPPFLAGS) -o $@ $+ $(LIBS)
+else
+scalerbench:
+	@echo "scalerbench can only be built and run in native builds, not with $(CXX)"
+	@false
+endif
+
 #
 # Rules to explicitly rebuild the credits / MD5 tables.
 # The rules for the files in the "web" resp. "docs" modules
@@ -0,0 +1,193 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+/*
+ * Scaler benchmark. Runs every scaler compiled in over generated 320x200
+ * and 640x480 frames and prints the throughput in source MPixels/s,
+ * together with a checksum of the output, so that optimized scalers can
+ * be checked against the previous implementation.
+ *
+ * Use the 'scalerbench' target to build and run it.
+ */
+
+// We use clock() and printf()
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "graphics/scaler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// The scalers are run without a backend. InitScalers() only needs one for
+// pixel formats other than 555 and 565.
+OSystem *g_system = 0;
+
+struct ScalerEntry {
+	const char *name;
+	ScalerProc *proc;
+	int scale;
+	int bytesPerPixel;	///< Output bytes per pixel
+};
+
+static const ScalerEntry s_scalers[] = {
+	// Normal1x converts to the 32 bit hardware screen format
+	{ "Normal1x", Normal1x, 1, 4 },
+#ifdef USE_SCALERS
+	{ "Normal2x", Normal2x, 2, 2 },
+	{ "Normal3x", Normal3x, 3, 2 },
+	{ "2xSaI", _2xSaI, 2, 2 },
+	{ "Super2xSaI", Super2xSaI, 2, 2 },
+	{ "SuperEagle", SuperEagle, 2, 2 },
+	{ "AdvMame2x", AdvMame2x, 2, 2 },
+	{ "AdvMame3x", AdvMame3x, 3, 2 },
+	{ "TV2x", TV2x, 2, 2 },
+	{ "DotMatrix", DotMatrix, 2, 2 },
+#ifdef USE_HQ_SCALERS
+	{ "HQ2x", HQ2x, 2, 2 },
+	{ "HQ3x", HQ3x, 3, 2 },
+#endif
+#endif
+	{ 0, 0, 0, 0 }
+};
+
+static uint32 s_seed = 1;
+
+static uint32 nextRandom() {
+	s_seed = s_seed * 1103515245 + 12345;
+	return s_seed >> 16;
+}
+
+static uint16 rgb565(int r, int g, int b) {
+	return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+}
+
+/**
+ * Fill a frame with content resembling game graphics: a dithered
+ * gradient backdrop, flat coloured boxes with hard edges, and thin lines
+ * and single pixels like text and sprite outlines. The frame has a one
+ * pixel border on every side, as the scalers read around the source rect.
+ */
+static void generateFrame(uint16 *frame, int width, int height) {
+	const int pitch = width + 2;
+
+	s_seed = width * height;
+	for (int y = 0; y < height + 2; ++y) {
+		for (int x = 0; x < pitch; ++x) {
+			const int dither = ((x ^ y) & 1) * 8;
+			frame[y * pitch + x] = rgb565((x * 255 / pitch + dither) & 0xFF, y * 255 / (height + 2), 96 + dither);
+		}
+	}
+
+	for (int i = 0; i < 40; ++i) {
+		const int w = nextRandom() % (width / 4) + 4;
+		const int h = nextRandom() % (height / 4) + 4;
+		const int x0 = nextRandom() % (pitch - w);
+		const int y0 = nextRandom() % (height + 2 - h);
+		const uint16 color = rgb565(nextRandom() & 0xFF, nextRandom() & 0xFF, nextRandom() & 0xFF);
+		for (int y = y0; y < y0 + h; ++y)
+			for (int x = x0; x < x0 + w; ++x)
+				frame[y * pitch + x] = color;
+	}
+
+	for (int i = 0; i < width * height / 16; ++i) {
+		const int x = nextRandom() % pitch;
+		const int y = nextRandom() % (height + 2);
+		frame[y * pitch + x] = (nextRandom() & 1) ? 0xFFFF : 0x0000;
+	}
+}
+
+static uint32 checksum(const uint8 *data, uint32 size) {
+	uint32 a = 1, b = 0;
+	for (uint32 i = 0; i < size; ++i) {
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	return (b << 16) | a;
+}
+
+static void runBenchmark(const ScalerEntry &scaler, const uint16 *frame, int width, int height) {
+	const uint32 srcPitch = (width + 2) * 2;
+	const uint32 dstPitch = width * scaler.scale * scaler.bytesPerPixel;
+	const uint32 dstSize = dstPitch * height * scaler.scale;
+	uint8 *dst = (uint8 *)malloc(dstSize);
+	memset(dst, 0, dstSize);
+
+	const uint8 *src = (const uint8 *)frame + srcPitch + 2;
+
+	// Time several rounds of at least a tenth of a second each and report
+	// the fastest, which is the one least disturbed by other processes.
+	double best = 0.0;
+	for (int round = 0; round < 5; ++round) {
+		uint32 frames = 0;
+		const clock_t start = clock();
+		clock_t elapsed;
+		do {
+			for (int i = 0; i < 5; ++i)
+				scaler.proc(src, srcPitch, dst, dstPitch, width, height);
+			frames += 5;
+			elapsed = clock() - start;
+		} while (elapsed < CLOCKS_PER_SEC / 10);
+
+		const double fps = frames * (double)CLOCKS_PER_SEC / elapsed;
+		if (fps > best)
+			best = fps;
+	}
+
+	printf("%-12s %4dx%-4d %9.1f MPixels/s  %8.1f fps  checksum %08x\n",
+		scaler.name, width, height, best * width * height / 1000000.0, best, checksum(dst, dstSize));
+
+	free(dst);
+}
+
+int main(int argc, char *argv[]) {
+	static const int sizes[][2] = { { 320, 200 }, { 640, 480 } };
+
+	InitScalers(565);
+
+	for (int s = 0; s < 2; ++s) {
+		const int width = sizes[s][0];
+		const int height = sizes[s][1];
+		uint16 *frame = (uint16 *)malloc((width + 2) * (height + 2) * 2);
+		generateFrame(frame, width, height);
+
+		for (const ScalerEntry *scaler = s_scalers; scaler->name; ++scaler) {
+			// Only run the scalers named on the command line, if any
+			bool selected = (argc < 2);
+			for (int i = 1; i < argc; ++i)
+				if (!scumm_stricmp(argv[i], scaler->name))
+					selected = true;
+
+			if (selected)
+				runBenchmark(*scaler, frame, width, height);
+		}
+
+		free(frame);
+	}
+
+	DestroyScalers();
+	return 0;
+}
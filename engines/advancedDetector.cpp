@@ -166,6 +166,32 @@ GameList AdvancedMetaEngine::detectGames(const Common::FSList &fslist) const {
 	return detectedGames;
 }
 
+bool AdvancedMetaEngine::getDetectionFileNames(Common::StringArray &names) const {
+	// Files in subdirectories and resource forks are not necessarily
+	// listed under their own names in the game directory
+	if ((_flags & kADFlagHasFallbackDetect) || _maxScanDepth > 1)
+		return false;
+
+	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> seen;
+
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameid != 0; descPtr += _descItemSize) {
+		const ADGameDescription *g = (const ADGameDescription *)descPtr;
+
+		// An entry without files matches every directory
+		if ((g->flags & ADGF_MACRESFORK) || !g->filesDescriptions[0].fileName)
+			return false;
+
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+			if (!seen.contains(fileDesc->fileName)) {
+				seen[fileDesc->fileName] = true;
+				names.push_back(fileDesc->fileName);
+			}
+		}
+	}
+
+	return true;
+}
+
 const ExtraGuiOptions AdvancedMetaEngine::getExtraGuiOptions(const Common::String &target) const {
 	if (!_extraGuiOptions)
 		return ExtraGuiOptions();
@@ -145,7 +145,15 @@ enum ADFlags {
 	 * In addition, this is useful if two variants of a game sharing the same
 	 * gameid are contained in a single directory.
 	 */
-	kADFlagUseExtraAsHint = (1 << 0)
+	kADFlagUseExtraAsHint = (1 << 0),
+
+	/**
+	 * Must be set by engines which implement fallbackDetect(). Without it
+	 * the engine is only asked to detect games in directories containing
+	 * at least one of the files from its detection table.
+	 * @see MetaEngine::getDetectionFileNames()
+	 */
+	kADFlagHasFallbackDetect = (1 << 1)
 };
 
 
@@ -262,6 +270,8 @@ public:
 
 	virtual GameList detectGames(const Common::FSList &fslist) const;
 
+	virtual bool getDetectionFileNames(Common::StringArray &names) const;
+
 	virtual Common::Error createInstance(OSystem *syst, Engine **engine) const;
 
 	virtual const ExtraGuiOptions getExtraGuiOptions(const Common::String &target) const;
@@ -275,6 +285,7 @@ protected:
 	/**
 	 * An (optional) generic fallback detect function which is invoked
 	 * if the regular MD5 based detection failed to detect anything.
+	 * Engines implementing it must set kADFlagHasFallbackDetect.
 	 */
 	virtual const ADGameDescription *fallbackDetect(const FileMap &allFiles, const Common::FSList &fslist) const {
 		return 0;
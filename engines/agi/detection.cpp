@@ -156,6 +156,7 @@ class AgiMetaEngine : public AdvancedMetaEngine {
 public:
 	AgiMetaEngine() : AdvancedMetaEngine(Agi::gameDescriptions, sizeof(Agi::AGIGameDescription), agiGames) {
 		_singleid = "agi";
+		_flags = kADFlagHasFallbackDetect;
 		_guioptions = GUIO1(GUIO_NOSPEECH);
 	}
 
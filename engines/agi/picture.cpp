@@ -41,6 +41,68 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 	_minCommand = 0xf0;
 	_flags = 0;
 	_currentStep = 0;
+
+	for (int i = 0; i < kPictureCacheSize; i++) {
+		_pictureCache[i].number = -1;
+		_pictureCache[i].buffer = NULL;
+		_pictureCache[i].lastUse = 0;
+	}
+	_pictureCacheTick = 0;
+}
+
+PictureMgr::~PictureMgr() {
+	for (int i = 0; i < kPictureCacheSize; i++)
+		free(_pictureCache[i].buffer);
+}
+
+/**
+ * Copy a previously drawn picture into the AGI screen.
+ * Only valid for pictures drawn onto a cleared screen.
+ * @param n AGI picture resource number
+ * @return true if the picture was found in the cache
+ */
+bool PictureMgr::restoreCachedPicture(int n) {
+	for (int i = 0; i < kPictureCacheSize; i++) {
+		CachedPicture &pic = _pictureCache[i];
+
+		if (pic.number != n)
+			continue;
+
+		if (pic.rdata != _data || pic.flen != _flen || pic.version != _pictureVersion) {
+			// The resource was reloaded or reinterpreted, draw it again
+			pic.number = -1;
+			return false;
+		}
+
+		memcpy(_vm->_game.sbuf16c, pic.buffer, _DEFAULT_WIDTH * _DEFAULT_HEIGHT);
+		pic.lastUse = ++_pictureCacheTick;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Remember the picture just drawn onto a cleared screen, replacing the
+ * least recently used cache slot.
+ * @param n AGI picture resource number
+ */
+void PictureMgr::cachePicture(int n) {
+	CachedPicture *slot = &_pictureCache[0];
+	for (int i = 1; i < kPictureCacheSize && slot->number != -1; i++) {
+		if (_pictureCache[i].number == -1 || _pictureCache[i].lastUse < slot->lastUse)
+			slot = &_pictureCache[i];
+	}
+
+	if (!slot->buffer)
+		slot->buffer = (uint8 *)malloc(_DEFAULT_WIDTH * _DEFAULT_HEIGHT);
+
+	slot->number = n;
+	slot->rdata = _data;
+	slot->flen = _flen;
+	slot->version = _pictureVersion;
+	slot->lastUse = ++_pictureCacheTick;
+	memcpy(slot->buffer, _vm->_game.sbuf16c, _DEFAULT_WIDTH * _DEFAULT_HEIGHT);
 }
 
 void PictureMgr::putVirtPixel(int x, int y) {
@@ -820,11 +882,20 @@ int PictureMgr::decodePicture(int n, int clr, bool agi256, int pic_width, int pi
 	_width = pic_width;
 	_height = pic_height;
 
-	if (clr && !agi256) // 256 color pictures should always fill the whole screen, so no clearing for them.
-		memset(_vm->_game.sbuf16c, 0x4f, _width * _height); // Clear 16 color AGI screen (Priority 4, color white).
+	// A picture drawn onto a cleared screen only depends on its data, so
+	// it can be restored from the cache instead of being drawn again.
+	const bool cacheable = clr && !agi256 && !_flags && _width == _DEFAULT_WIDTH && _height == _DEFAULT_HEIGHT;
+
+	if (cacheable && restoreCachedPicture(n)) {
+		debugC(8, kDebugLevelResources, "picture %d restored from cache", n);
+	} else if (!agi256) {
+		if (clr) // 256 color pictures should always fill the whole screen, so no clearing for them.
+			memset(_vm->_game.sbuf16c, 0x4f, _width * _height); // Clear 16 color AGI screen (Priority 4, color white).
 
-	if (!agi256) {
 		drawPicture(); // Draw 16 color picture.
+
+		if (cacheable)
+			cachePicture(n);
 	} else {
 		const uint32 maxFlen = _width * _height;
 		memcpy(_vm->_game.sbuf256c, _data, MIN(_flen, maxFlen)); // Draw 256 color picture.
@@ -75,8 +75,12 @@ private:
 
 	uint8 nextByte() { return _data[_foffs++]; }
 
+	bool restoreCachedPicture(int n);
+	void cachePicture(int n);
+
 public:
 	PictureMgr(AgiBase *agi, GfxMgr *gfx);
+	~PictureMgr();
 
 	void putVirtPixel(int x, int y);
 
@@ -137,6 +141,26 @@ private:
 
 	int _flags;
 	int _currentStep;
+
+	/**
+	 * A fully drawn picture, as it ends up in the 16 color (+priority)
+	 * screen buffer when drawn onto a cleared screen.
+	 */
+	struct CachedPicture {
+		int number;
+		const uint8 *rdata;		/**< raw data the picture was drawn from */
+		uint32 flen;
+		AgiPictureVersion version;
+		uint32 lastUse;
+		uint8 *buffer;
+	};
+
+	enum {
+		kPictureCacheSize = 8
+	};
+
+	CachedPicture _pictureCache[kPictureCacheSize];
+	uint32 _pictureCacheTick;
 };
 
 } // End of namespace Agi
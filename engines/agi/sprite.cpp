@@ -81,7 +81,7 @@ void SpritesMgr::poolRelease(void *s) {
  */
 
 // Blit one pixel considering the priorities
-void SpritesMgr::blitPixel(uint8 *p, uint8 *end, uint8 col, int spr, int width, int *hidden) {
+void SpritesMgr::blitPixel(uint8 *p, uint8 *end, uint8 col, int spr, int width, int *hidden, bool agi256) {
 	int epr = 0, pr = 0;	// effective and real priorities
 
 	// CM: priority 15 overrides control lines and is ignored when
@@ -110,7 +110,7 @@ void SpritesMgr::blitPixel(uint8 *p, uint8 *end, uint8 col, int spr, int width,
 	if (spr >= epr) {
 		// Keep control line information visible, but put our
 		// priority over water (0x30) surface
-		if (_vm->getFeatures() & (GF_AGI256 | GF_AGI256_2))
+		if (agi256)
 			*(p + FROM_SBUF16_TO_SBUF256_OFFSET) = col; // Write to 256 color buffer
 		else
 			*p = (pr < 0x30 ? pr : spr) | col; // Write to 16 color (+control line/priority info) buffer
@@ -132,6 +132,7 @@ int SpritesMgr::blitCel(int x, int y, int spr, ViewCel *c, bool agi256_2) {
 	uint8 *p0, *p, *q = NULL, *end;
 	int i, j, t, m, col;
 	int hidden = true;
+	const bool agi256 = (_vm->getFeatures() & (GF_AGI256 | GF_AGI256_2)) != 0;
 
 	// Fixes Sarien bug #477841 (crash in PQ1 map C4 when y == -2)
 	if (y < 0)
@@ -155,10 +156,13 @@ int SpritesMgr::blitCel(int x, int y, int spr, ViewCel *c, bool agi256_2) {
 		p = p0;
 		while (*q) {
 			col = agi256_2 ? *q : (*q & 0xf0) >> 4; // Uses whole byte for color info with AGI256-2
-			for (j = agi256_2 ? 1 : *q & 0x0f; j; j--, p += 1 - 2 * m) { // No RLE with AGI256-2
-				if (col != t) {
-					blitPixel(p, end, col, spr, _WIDTH, &hidden);
-				}
+			j = agi256_2 ? 1 : *q & 0x0f; // No RLE with AGI256-2
+			if (col == t) {
+				// Skip transparent runs as a whole
+				p += j * (1 - 2 * m);
+			} else {
+				for (; j; j--, p += 1 - 2 * m)
+					blitPixel(p, end, col, spr, _WIDTH, &hidden, agi256);
 			}
 			q++;
 		}
@@ -50,7 +50,7 @@ private:
 
 	void *poolAlloc(int size);
 	void poolRelease(void *s);
-	void blitPixel(uint8 *p, uint8 *end, uint8 col, int spr, int width, int *hidden);
+	void blitPixel(uint8 *p, uint8 *end, uint8 col, int spr, int width, int *hidden, bool agi256);
 	int blitCel(int x, int y, int spr, ViewCel *c, bool agi256_2);
 	void objsSaveArea(Sprite *s);
 	void objsRestoreArea(Sprite *s);
@@ -32,15 +32,34 @@
 
 namespace Gob {
 
-DataIO::File::File() : size(0), offset(0), compression(0), archive(0) {
+namespace {
+
+struct FreeDeleter {
+	void operator()(byte *data) { free(data); }
+};
+
+/** A memory stream keeping a reference on the shared buffer it reads from. */
+class SharedMemoryReadStream : public Common::MemoryReadStream {
+public:
+	SharedMemoryReadStream(const Common::SharedPtr<byte> &data, uint32 size) :
+		Common::MemoryReadStream(data.get(), size), _data(data) {
+	}
+
+private:
+	Common::SharedPtr<byte> _data;
+};
+
+} // End of anonymous namespace
+
+DataIO::File::File() : size(0), offset(0), compression(0), archive(0), unpackedSize(0) {
 }
 
 DataIO::File::File(const Common::String &n, uint32 s, uint32 o, uint8 c, Archive &a) :
-	name(n), size(s), offset(o), compression(c), archive(&a) {
+	name(n), size(s), offset(o), compression(c), archive(&a), unpackedSize(0) {
 }
 
 
-DataIO::DataIO() {
+DataIO::DataIO() : _unpackedCacheSize(0) {
 	// Reserve memory for the standard max amount of archives
 	_archives.reserve(kMaxArchives);
 	for (int i = 0; i < kMaxArchives; i++)
@@ -302,6 +321,8 @@ bool DataIO::closeArchive(bool base) {
 }
 
 bool DataIO::closeArchive(Archive &archive) {
+	dropUnpacked(archive);
+
 	archive.file.close();
 
 	return true;
@@ -407,29 +428,39 @@ Common::SeekableReadStream *DataIO::getFile(File &file) {
 	if (!file.archive)
 		return 0;
 
+	if (file.compression != 0) {
+		int32 size;
+		Common::SharedPtr<byte> data = getUnpacked(file, size);
+		if (!data)
+			return 0;
+
+		return new SharedMemoryReadStream(data, size);
+	}
+
 	if (!file.archive->file.isOpen())
 		return 0;
 
 	if (!file.archive->file.seek(file.offset))
 		return 0;
 
-	Common::SeekableReadStream *rawData =
-		new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
-
-	if (file.compression == 0)
-		return rawData;
-
-	Common::SeekableReadStream *unpackedData = unpack(*rawData, file.compression);
-
-	delete rawData;
-
-	return unpackedData;
+	return new Common::SafeSeekableSubReadStream(&file.archive->file, file.offset, file.offset + file.size);
 }
 
 byte *DataIO::getFile(File &file, int32 &size) {
 	if (!file.archive)
 		return 0;
 
+	if (file.compression != 0) {
+		// The caller owns (and may modify) the buffer, so hand out a copy
+		Common::SharedPtr<byte> data = getUnpacked(file, size);
+		if (!data)
+			return 0;
+
+		byte *copy = new byte[size];
+		memcpy(copy, data.get(), size);
+		return copy;
+	}
+
 	if (!file.archive->file.isOpen())
 		return 0;
 
@@ -444,14 +475,69 @@ byte *DataIO::getFile(File &file, int32 &size) {
 		return 0;
 	}
 
-	if (file.compression == 0)
-		return rawData;
+	return rawData;
+}
+
+Common::SharedPtr<byte> DataIO::getUnpacked(File &file, int32 &size) {
+	if (file.unpacked) {
+		// Mark as most recently used
+		_unpackedCache.remove(&file);
+		_unpackedCache.push_back(&file);
+
+		size = file.unpackedSize;
+		return file.unpacked;
+	}
 
-	byte *unpackedData = unpack(rawData, file.size, size, file.compression);
+	if (!file.archive->file.isOpen() || !file.archive->file.seek(file.offset))
+		return Common::SharedPtr<byte>();
+
+	// Unpacking byte by byte from a file is slow, read the packed data in one go
+	byte *rawData = new byte[file.size];
+	if (file.archive->file.read(rawData, file.size) != file.size) {
+		delete[] rawData;
+		return Common::SharedPtr<byte>();
+	}
+
+	Common::MemoryReadStream rawStream(rawData, file.size);
+	Common::SharedPtr<byte> data(unpack(rawStream, size, file.compression, true), FreeDeleter());
 
 	delete[] rawData;
 
-	return unpackedData;
+	if ((uint32)size > kUnpackedCacheSize / 2)
+		return data;
+
+	while (!_unpackedCache.empty() && (_unpackedCacheSize + size > kUnpackedCacheSize)) {
+		File *oldest = _unpackedCache.front();
+		_unpackedCache.pop_front();
+
+		_unpackedCacheSize -= oldest->unpackedSize;
+		oldest->unpacked.reset();
+		oldest->unpackedSize = 0;
+	}
+
+	file.unpacked     = data;
+	file.unpackedSize = size;
+
+	_unpackedCache.push_back(&file);
+	_unpackedCacheSize += size;
+
+	return data;
+}
+
+void DataIO::dropUnpacked(const Archive &archive) {
+	Common::List<File *>::iterator it = _unpackedCache.begin();
+	while (it != _unpackedCache.end()) {
+		if ((*it)->archive != &archive) {
+			++it;
+			continue;
+		}
+
+		_unpackedCacheSize -= (*it)->unpackedSize;
+		(*it)->unpacked.reset();
+		(*it)->unpackedSize = 0;
+
+		it = _unpackedCache.erase(it);
+	}
 }
 
 } // End of namespace Gob
@@ -28,6 +28,8 @@
 #include "common/hashmap.h"
 #include "common/array.h"
 #include "common/file.h"
+#include "common/list.h"
+#include "common/ptr.h"
 
 namespace Common {
 class SeekableReadStream;
@@ -64,6 +66,9 @@ public:
 private:
 	static const int kMaxArchives = 8;
 
+	/** Memory budget for unpacked archive members kept around. */
+	static const uint32 kUnpackedCacheSize = 2 * 1024 * 1024;
+
 	struct Archive;
 
 	struct File {
@@ -74,6 +79,9 @@ private:
 
 		Archive *archive;
 
+		Common::SharedPtr<byte> unpacked; ///< Cached unpacked data, if any.
+		int32 unpackedSize;
+
 		File();
 		File(const Common::String &n, uint32 s, uint32 o, uint8 c, Archive &a);
 	};
@@ -91,6 +99,9 @@ private:
 
 	Common::Array<Archive *> _archives;
 
+	Common::List<File *> _unpackedCache; ///< Files with unpacked data, least recently used first.
+	uint32 _unpackedCacheSize;
+
 	Archive *openArchive(const Common::String &name);
 	bool closeArchive(Archive &archive);
 
@@ -99,6 +110,9 @@ private:
 	Common::SeekableReadStream *getFile(File &file);
 	byte *getFile(File &file, int32 &size);
 
+	Common::SharedPtr<byte> getUnpacked(File &file, int32 &size);
+	void dropUnpacked(const Archive &archive);
+
 	static byte *unpack(Common::SeekableReadStream &src, int32 &size, uint8 compression, bool useMalloc);
 
 	static uint32 getSizeChunks(Common::SeekableReadStream &src);
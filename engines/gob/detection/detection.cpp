@@ -57,6 +57,7 @@ GobMetaEngine::GobMetaEngine() :
 
 	_singleid   = "gob";
 	_guioptions = GUIO1(GUIO_NOLAUNCHLOAD);
+	_flags      = kADFlagHasFallbackDetect;
 }
 
 GameDescriptor GobMetaEngine::findGame(const char *gameid) const {
@@ -522,6 +522,7 @@ class MadeMetaEngine : public AdvancedMetaEngine {
 public:
 	MadeMetaEngine() : AdvancedMetaEngine(Made::gameDescriptions, sizeof(Made::MadeGameDescription), madeGames) {
 		_singleid = "made";
+		_flags = kADFlagHasFallbackDetect;
 	}
 
 	virtual const char *getName() const {
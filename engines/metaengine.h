@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/error.h"
 #include "common/array.h"
+#include "common/str-array.h"
 
 #include "engines/game.h"
 #include "engines/savestate.h"
@@ -80,6 +81,19 @@ public:
 	 */
 	virtual GameList detectGames(const Common::FSList &fslist) const = 0;
 
+	/**
+	 * Collects the names of the files detectGames() looks for. The plugin
+	 * manager keeps these in its plugin index, so that the engine is only
+	 * loaded for detection in directories containing one of them.
+	 *
+	 * @param names	the list to which the file names are added
+	 * @return false if games may also be detected without any of the
+	 *         files, in which case the engine is always asked
+	 */
+	virtual bool getDetectionFileNames(Common::StringArray &names) const {
+		return false;
+	}
+
 	/**
 	 * Tries to instantiate an engine instance based on the settings of
 	 * the currently active ConfMan target. That is, the MetaEngine should
@@ -163,6 +163,7 @@ class MohawkMetaEngine : public AdvancedMetaEngine {
 public:
 	MohawkMetaEngine() : AdvancedMetaEngine(Mohawk::gameDescriptions, sizeof(Mohawk::MohawkGameDescription), mohawkGames) {
 		_singleid = "mohawk";
+		_flags = kADFlagHasFallbackDetect;
 		_maxScanDepth = 2;
 		_directoryGlobs = directoryGlobs;
 	}
@@ -463,6 +463,7 @@ class SciMetaEngine : public AdvancedMetaEngine {
 public:
 	SciMetaEngine() : AdvancedMetaEngine(Sci::SciGameDescriptions, sizeof(ADGameDescription), s_sciGameTitles, optionsList) {
 		_singleid = "sci";
+		_flags = kADFlagHasFallbackDetect;
 	}
 
 	virtual const char *getName() const {
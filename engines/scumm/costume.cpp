@@ -230,13 +230,22 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 
 	v1.replen = 0;
 
+	// Unscaled limbs are drawn from their cached, decoded form
+	const DecodedLimb *decoded = NULL;
+	int startCol = 0;
+	if (!use_scaling && !newAmiCost && !pcEngCost && _loaded._format != 0x57)
+		decoded = getDecodedLimb(v1);
+
 	if (_mirror) {
 		if (!use_scaling)
 			skip = -v1.x;
 		if (skip > 0) {
 			if (!newAmiCost && !pcEngCost && _loaded._format != 0x57) {
 				v1.skip_width -= skip;
-				codec1_ignorePakCols(v1, skip);
+				if (decoded)
+					startCol = skip;
+				else
+					codec1_ignorePakCols(v1, skip);
 				v1.x = 0;
 			}
 		} else {
@@ -253,7 +262,10 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		if (skip > 0) {
 			if (!newAmiCost && !pcEngCost && _loaded._format != 0x57) {
 				v1.skip_width -= skip;
-				codec1_ignorePakCols(v1, skip);
+				if (decoded)
+					startCol = skip;
+				else
+					codec1_ignorePakCols(v1, skip);
 				v1.x = _out.w - 1;
 			}
 		} else {
@@ -305,12 +317,165 @@ byte ClassicCostumeRenderer::mainRoutine(int xmoveCur, int ymoveCur) {
 		proc3_ami(v1);
 	else if (pcEngCost)
 		procPCEngine(v1);
+	else if (decoded)
+		procDecoded(v1, *decoded, startCol);
 	else
 		proc3(v1);
 
 	return drawFlag;
 }
 
+// Decoded limbs are dropped all at once when they take more than this
+static const uint32 kLimbCacheMaxSize = 1024 * 1024;
+
+ClassicCostumeRenderer::~ClassicCostumeRenderer() {
+	clearLimbCache();
+}
+
+void ClassicCostumeRenderer::clearLimbCache() {
+	for (DecodedLimbMap::iterator i = _limbCache.begin(); i != _limbCache.end(); ++i) {
+		free(i->_value.pixels);
+		free(i->_value.spans);
+	}
+	_limbCache.clear();
+	_limbCacheSize = 0;
+}
+
+const ClassicCostumeRenderer::DecodedLimb *ClassicCostumeRenderer::getDecodedLimb(const Codec1 &v1) {
+	const uint32 offset = _srcptr - _loaded._baseptr;
+	if (_loaded._id < 0 || _loaded._id >= 0x8000 || offset >= 0x20000)
+		return NULL;
+
+	const uint32 key = ((uint32)_loaded._id << 17) | offset;
+	DecodedLimbMap::iterator it = _limbCache.find(key);
+	if (it != _limbCache.end()) {
+		// The costume resource may have been reloaded somewhere else
+		if (it->_value.srcptr == _srcptr && it->_value.width == _width && it->_value.height == _height)
+			return &it->_value;
+
+		free(it->_value.pixels);
+		free(it->_value.spans);
+		_limbCacheSize -= it->_value.width * (it->_value.height + 4);
+		_limbCache.erase(it);
+	}
+
+	const uint32 size = _width * (_height + 4);
+	if (_width <= 0 || _height <= 0 || size > kLimbCacheMaxSize / 4)
+		return NULL;
+	if (_limbCacheSize + size > kLimbCacheMaxSize)
+		clearLimbCache();
+
+	DecodedLimb limb;
+	limb.srcptr = _srcptr;
+	limb.width = _width;
+	limb.height = _height;
+	limb.pixels = (byte *)malloc(_width * _height);
+	limb.spans = (uint16 *)malloc(_width * 2 * sizeof(uint16));
+
+	// Expand the RLE data, which runs column by column just like proc3
+	// walks it. A zero length byte is followed by the real length, and
+	// a real length of zero means 256 pixels.
+	const byte *src = _srcptr;
+	byte *dst = limb.pixels;
+	int remaining = _width * _height;
+	while (remaining > 0) {
+		int len = *src++;
+		const byte color = len >> v1.shr;
+		len &= v1.mask;
+		if (!len)
+			len = *src++;
+		if (!len)
+			len = 256;
+		len = MIN(len, remaining);
+		memset(dst, color, len);
+		dst += len;
+		remaining -= len;
+	}
+
+	for (int x = 0; x < _width; x++) {
+		const byte *col = limb.pixels + x * _height;
+		int first = 0, last = _height;
+		while (first < last && !col[first])
+			first++;
+		while (last > first && !col[last - 1])
+			last--;
+		limb.spans[x * 2 + 0] = first;
+		limb.spans[x * 2 + 1] = last;
+	}
+
+	_limbCacheSize += size;
+	_limbCache[key] = limb;
+	return &_limbCache[key];
+}
+
+void ClassicCostumeRenderer::procDecoded(Codec1 &v1, const DecodedLimb &limb, int startCol) {
+	const int step = v1.scaleXstep;
+
+	// Rows of the limb which are on screen
+	const int rowMin = MAX(0, -v1.y);
+	const int rowMax = MIN<int>(_height, _out.h - v1.y);
+	if (rowMin >= rowMax)
+		return;
+
+	// Columns of the screen the limb can touch
+	int xa = v1.x, xb = v1.x + step * (v1.skip_width - 1);
+	if (xa > xb)
+		SWAP(xa, xb);
+	xa = MAX(xa, 0);
+	xb = MIN<int>(xb, _out.w - 1);
+	if (xa > xb)
+		return;
+
+	// Only test every pixel against the z-plane if the mask is set
+	// anywhere below the limb.
+	bool useMask = false;
+	for (int row = rowMin; row < rowMax && !useMask; row++) {
+		const byte *mask = v1.mask_ptr + row * _numStrips;
+		for (int strip = xa / 8; strip <= xb / 8; strip++) {
+			if (mask[strip]) {
+				useMask = true;
+				break;
+			}
+		}
+	}
+
+	int x = v1.x;
+	byte *destCol = v1.destptr;
+	for (int col = startCol; col < limb.width; col++) {
+		if (x >= 0 && x < _out.w) {
+			const int r0 = MAX<int>(rowMin, limb.spans[col * 2 + 0]);
+			const int r1 = MIN<int>(rowMax, limb.spans[col * 2 + 1]);
+			const byte *src = limb.pixels + col * _height;
+			const byte *mask = v1.mask_ptr + r0 * _numStrips + x / 8;
+			const byte maskbit = revBitMask(x & 7);
+			byte *dst = destCol + r0 * _out.pitch;
+
+			for (int row = r0; row < r1; row++, dst += _out.pitch, mask += _numStrips) {
+				const byte color = src[row];
+				if (!color || (useMask && (*mask & maskbit)))
+					continue;
+
+				uint pcolor;
+				if (_shadow_mode & 0x20) {
+					pcolor = _shadow_table[*dst];
+				} else {
+					pcolor = _palette[color];
+					if (pcolor == 13 && _shadow_table)
+						pcolor = _shadow_table[*dst];
+				}
+				*dst = pcolor;
+			}
+		}
+
+		if (!--v1.skip_width)
+			return;
+		x += step;
+		if (x < 0 || x >= _out.w)
+			return;
+		destCol += step;
+	}
+}
+
 static const int v1MMActorPalatte1[25] = {
 	8, 8, 8, 8, 4, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8
 };
@@ -22,6 +22,8 @@
 #ifndef SCUMM_COSTUME_H
 #define SCUMM_COSTUME_H
 
+#include "common/hashmap.h"
+
 #include "scumm/base-costume.h"
 
 namespace Scumm {
@@ -87,8 +89,25 @@ protected:
 	byte _scaleIndexY;
 	uint16 _palette[32];
 
+	/**
+	 * An unscaled limb frame with its RLE data expanded. Pixels are
+	 * stored column by column as costume color indices, 0 being
+	 * transparent, so they can be drawn with any actor palette.
+	 */
+	struct DecodedLimb {
+		const byte *srcptr;	///< The RLE data this was decoded from
+		uint16 width, height;
+		byte *pixels;
+		uint16 *spans;		///< First and last+1 opaque row of each column
+	};
+	typedef Common::HashMap<uint32, DecodedLimb> DecodedLimbMap;
+
+	DecodedLimbMap _limbCache;
+	uint32 _limbCacheSize;
+
 public:
-	ClassicCostumeRenderer(ScummEngine *vm) : BaseCostumeRenderer(vm), _loaded(vm) {}
+	ClassicCostumeRenderer(ScummEngine *vm) : BaseCostumeRenderer(vm), _loaded(vm), _limbCacheSize(0) {}
+	~ClassicCostumeRenderer();
 
 	void setPalette(uint16 *palette);
 	void setFacing(const Actor *a);
@@ -100,6 +119,10 @@ protected:
 	void proc3(Codec1 &v1);
 	void proc3_ami(Codec1 &v1);
 
+	const DecodedLimb *getDecodedLimb(const Codec1 &v1);
+	void procDecoded(Codec1 &v1, const DecodedLimb &limb, int startCol);
+	void clearLimbCache();
+
 	void procC64(Codec1 &v1, int actor);
 
 	void procPCEngine(Codec1 &v1);
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/file.h"
 #include "common/str.h"
@@ -32,8 +33,14 @@
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
+#include "scumm/snapshot.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/scumm_v7.h"
+#include "scumm/smush/smush_player.h"
+#endif
 
 namespace Scumm {
 
@@ -88,6 +95,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 
 	DCmd_Register("loadgame",  WRAP_METHOD(ScummDebugger, Cmd_LoadGame));
 	DCmd_Register("savegame",  WRAP_METHOD(ScummDebugger, Cmd_SaveGame));
+	DCmd_Register("snapshots", WRAP_METHOD(ScummDebugger, Cmd_Snapshots));
 
 	DCmd_Register("level",     WRAP_METHOD(ScummDebugger, Cmd_DebugLevel));
 	DCmd_Register("debug",     WRAP_METHOD(ScummDebugger, Cmd_Debug));
@@ -96,6 +104,11 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("hide",      WRAP_METHOD(ScummDebugger, Cmd_Hide));
 
 	DCmd_Register("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
+	DCmd_Register("profile",   WRAP_METHOD(ScummDebugger, Cmd_Profile));
+#ifdef ENABLE_SCUMM_7_8
+	if (_vm->_game.version >= 7)
+		DCmd_Register("smush",   WRAP_METHOD(ScummDebugger, Cmd_Smush));
+#endif
 
 	DCmd_Register("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
 }
@@ -165,6 +178,130 @@ bool ScummDebugger::Cmd_IMuse(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef ENABLE_SCUMM_7_8
+bool ScummDebugger::Cmd_Smush(int argc, const char **argv) {
+	SmushPlayer *player = ((ScummEngine_v7 *)_vm)->_splayer;
+	if (!player) {
+		DebugPrintf("No SMUSH player is active.\n");
+		return true;
+	}
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			player->resetStats();
+			DebugPrintf("SMUSH statistics reset.\n");
+		} else {
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const SmushPlayer::Stats &stats = player->getStats();
+	DebugPrintf("Frames decoded: %d\n", stats.framesDecoded);
+	DebugPrintf("Frames shown:   %d\n", stats.framesShown);
+	DebugPrintf("Slowest decode: %d ms\n", stats.maxDecodeTime);
+	return true;
+}
+#endif
+
+namespace {
+
+struct ProfileEntry {
+	uint32 id;
+	ScriptProfiler::Totals totals;
+};
+
+bool profileEntryLess(const ProfileEntry &a, const ProfileEntry &b) {
+	if (a.totals.elapsed != b.totals.elapsed)
+		return a.totals.elapsed > b.totals.elapsed;
+	return a.totals.calls > b.totals.calls;
+}
+
+void sortProfileEntries(Common::Array<ProfileEntry> &entries, const Common::HashMap<uint32, ScriptProfiler::Totals> &totals) {
+	for (Common::HashMap<uint32, ScriptProfiler::Totals>::const_iterator i = totals.begin(); i != totals.end(); ++i) {
+		ProfileEntry entry;
+		entry.id = i->_key;
+		entry.totals = i->_value;
+		entries.push_back(entry);
+	}
+	Common::sort(entries.begin(), entries.end(), profileEntryLess);
+}
+
+} // End of anonymous namespace
+
+bool ScummDebugger::Cmd_Profile(int argc, const char **argv) {
+	if (!_vm->_scriptProfiler)
+		_vm->_scriptProfiler = new ScriptProfiler(_vm);
+	ScriptProfiler *profiler = _vm->_scriptProfiler;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "full")) {
+			profiler->setMode(ScriptProfiler::kModeFull);
+			DebugPrintf("Counting and timing every opcode.\n");
+		} else if (!strcmp(argv[1], "sample")) {
+			profiler->setMode(ScriptProfiler::kModeSampling);
+			DebugPrintf("Sampling the script stack once per millisecond.\n");
+		} else if (!strcmp(argv[1], "off")) {
+			profiler->setMode(ScriptProfiler::kModeOff);
+			DebugPrintf("Script profiler stopped.\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			profiler->reset();
+			DebugPrintf("Script profile cleared.\n");
+		} else if (!strcmp(argv[1], "dump") && argc > 2) {
+			Common::DumpFile file;
+			if (!file.open(argv[2])) {
+				DebugPrintf("Could not open '%s' for writing.\n", argv[2]);
+				return true;
+			}
+			profiler->writeCollapsed(file);
+			file.finalize();
+			DebugPrintf("Wrote collapsed stacks to '%s'.\n", argv[2]);
+		} else {
+			DebugPrintf("Usage: %s [full|sample|off|reset|dump <file>]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const bool sampling = profiler->getMode() == ScriptProfiler::kModeSampling;
+	const char *unit = sampling ? "samples" : "ms";
+
+	Common::Array<ProfileEntry> opcodes;
+	ScriptProfiler::Totals opcodeTotals[256];
+	profiler->getOpcodeTotals(opcodeTotals);
+	for (int i = 0; i < 256; i++) {
+		if (opcodeTotals[i].calls || opcodeTotals[i].elapsed) {
+			ProfileEntry entry;
+			entry.id = i;
+			entry.totals = opcodeTotals[i];
+			opcodes.push_back(entry);
+		}
+	}
+	Common::sort(opcodes.begin(), opcodes.end(), profileEntryLess);
+
+	DebugPrintf("Top opcodes:\n");
+	for (uint i = 0; i < opcodes.size() && i < 10; i++)
+		DebugPrintf("  [%02X] %-24s %8d calls %6d %s\n", opcodes[i].id, _vm->getOpcodeDesc(opcodes[i].id),
+		            opcodes[i].totals.calls, opcodes[i].totals.elapsed, unit);
+
+	Common::HashMap<uint32, ScriptProfiler::Totals> totals;
+	Common::Array<ProfileEntry> entries;
+
+	profiler->getScriptTotals(totals);
+	sortProfileEntries(entries, totals);
+	DebugPrintf("Top scripts:\n");
+	for (uint i = 0; i < entries.size() && i < 10; i++)
+		DebugPrintf("  script %-5d %8d opcodes %6d %s\n", entries[i].id, entries[i].totals.calls, entries[i].totals.elapsed, unit);
+
+	entries.clear();
+	profiler->getRoomTotals(totals);
+	sortProfileEntries(entries, totals);
+	DebugPrintf("Top rooms:\n");
+	for (uint i = 0; i < entries.size() && i < 10; i++)
+		DebugPrintf("  room %-7d %8d opcodes %6d %s\n", entries[i].id, entries[i].totals.calls, entries[i].totals.elapsed, unit);
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_Room(int argc, const char **argv) {
 	if (argc > 1) {
 		int room = atoi(argv[1]);
@@ -204,6 +341,34 @@ bool ScummDebugger::Cmd_SaveGame(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Snapshots(int argc, const char **argv) {
+	SnapshotRing *snapshots = _vm->_snapshots;
+	const int count = snapshots ? snapshots->size() : 0;
+
+	if (argc > 2 && !strcmp(argv[1], "load")) {
+		int age = atoi(argv[2]);
+		if (age < 0 || age >= count) {
+			DebugPrintf("No snapshot %d\n", age);
+			return true;
+		}
+
+		_vm->requestSnapshotLoad(age);
+
+		detach();
+		return false;
+	} else if (argc > 1) {
+		DebugPrintf("Syntax: snapshots [load <age>]\n");
+		return true;
+	}
+
+	for (int age = 0; age < count; age++)
+		DebugPrintf("%2d: slot %-3d %7d bytes, %7d stored%s\n", age, snapshots->getSlot(age),
+		            snapshots->getSize(age), snapshots->getStoredSize(age),
+		            (age == 0 && snapshots->isPending()) ? ", not on disk" : "");
+	DebugPrintf("%d snapshots, %d bytes in memory\n", count, snapshots ? snapshots->getMemoryUsage() : 0);
+	return true;
+}
+
 bool ScummDebugger::Cmd_Show(int argc, const char **argv) {
 
 	if (argc != 2) {
@@ -40,6 +40,7 @@ private:
 	bool Cmd_Room(int argc, const char **argv);
 	bool Cmd_LoadGame(int argc, const char **argv);
 	bool Cmd_SaveGame(int argc, const char **argv);
+	bool Cmd_Snapshots(int argc, const char **argv);
 	bool Cmd_Restart(int argc, const char **argv);
 
 	bool Cmd_PrintActor(int argc, const char **argv);
@@ -63,6 +64,10 @@ private:
 	bool Cmd_Hide(int argc, const char **argv);
 
 	bool Cmd_IMuse(int argc, const char **argv);
+	bool Cmd_Profile(int argc, const char **argv);
+#ifdef ENABLE_SCUMM_7_8
+	bool Cmd_Smush(int argc, const char **argv);
+#endif
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
@@ -684,9 +684,29 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
+			// If the backend renders straight from its screen surface, and
+			// the composed strip would go to the screen unchanged, compose
+			// it right into the screen instead of copying it there later.
+			Graphics::Surface *screen = 0;
+			if (m == 1 && _game.platform != Common::kPlatformNES &&
+				_renderMode != Common::kRenderHercA && _renderMode != Common::kRenderHercG &&
+				_renderMode != Common::kRenderCGA &&
+				_system->hasFeature(OSystem::kFeatureDirectScreenAccess)) {
+				screen = _system->lockScreen();
+				if (screen && screen->format.bytesPerPixel != 1) {
+					_system->unlockScreen();
+					screen = 0;
+				}
+			}
+
 			// We blit four pixels at a time, for improved performance.
 			const uint32 *src32 = (const uint32 *)src;
 			uint32 *dst32 = (uint32 *)_compositeBuf;
+			int dstPitch = 0;
+			if (screen) {
+				dst32 = (uint32 *)screen->getBasePtr(x, y);
+				dstPitch = (screen->pitch - width) >> 2;
+			}
 
 			vsPitch >>= 2;
 
@@ -713,6 +733,12 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 				}
 				src32 += vsPitch;
 				text32 += textPitch;
+				dst32 += dstPitch;
+			}
+
+			if (screen) {
+				_system->unlockScreenRect(Common::Rect(x, y, x + width, y + height));
+				return;
 			}
 #endif
 		}
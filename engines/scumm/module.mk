@@ -64,7 +64,9 @@ MODULE_OBJS := \
 	script_v5.o \
 	script_v6.o \
 	script.o \
+	script_profiler.o \
 	scumm.o \
+	snapshot.o \
 	sound.o \
 	string.o \
 	usage_bits.o \
@@ -37,6 +37,7 @@
 #include "scumm/saveload.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v7.h"
+#include "scumm/snapshot.h"
 #include "scumm/sound.h"
 #include "scumm/he/sprite_he.h"
 #include "scumm/verbs.h"
@@ -148,7 +149,15 @@ void ScummEngine::requestLoad(int slot) {
 	_saveLoadFlag = 2;		// 2 for load
 }
 
-static bool saveSaveGameHeader(Common::OutSaveFile *out, SaveGameHeader &hdr) {
+void ScummEngine::requestSnapshotLoad(int age) {
+	assert(_snapshots && age >= 0 && age < (int)_snapshots->size());
+	_saveLoadSlot = _snapshots->getSlot(age);
+	_saveTemporaryState = true;
+	_saveLoadSnapshot = age;
+	_saveLoadFlag = 2;		// 2 for load
+}
+
+static bool saveSaveGameHeader(Common::WriteStream *out, SaveGameHeader &hdr) {
 	hdr.type = MKTAG('S','C','V','M');
 	hdr.size = 0;
 	hdr.ver = CURRENT_VER;
@@ -182,6 +191,14 @@ bool ScummEngine::saveState(int slot, bool compat) {
 	Common::String filename;
 	Common::OutSaveFile *out;
 
+	// Temporary states are only kept in memory until they are needed on disk
+	if (compat && _saveLoadSlot != 255)
+		return saveSnapshot(slot);
+
+	// A regular save may be restored in a later session, which then also
+	// needs the temporary state the game saved last.
+	flushSnapshot();
+
 	pauseEngine(true);
 
 	if (_saveLoadSlot == 255) {
@@ -213,6 +230,64 @@ bool ScummEngine::saveState(int slot, bool compat) {
 	return true;
 }
 
+bool ScummEngine::saveSnapshot(int slot) {
+	if (!_snapshots)
+		_snapshots = new SnapshotRing();
+
+	// Only one snapshot is waiting to be written at any time. Replacing
+	// it with a state for the same slot makes writing it unnecessary.
+	if (_snapshots->isPending() && _snapshots->getSlot(0) != slot)
+		flushSnapshot();
+
+	uint32 startTime = _system->getMillis();
+
+	// Same layout as a save file, minus the thumbnail
+	SaveGameHeader hdr;
+	Common::strlcpy(hdr.name, _saveLoadDescription.c_str(), sizeof(hdr.name));
+
+	Common::WriteStream *out = _snapshots->beginSnapshot();
+	saveSaveGameHeader(out, hdr);
+	saveInfos(out);
+
+	Serializer ser(0, out, CURRENT_VER);
+	saveOrLoad(&ser);
+
+	if (out->err()) {
+		debug(1, "Snapshot of slot %d FAILED", slot);
+		return false;
+	}
+
+	_snapshots->commitSnapshot(slot);
+	_snapshots->setPending(true);
+
+	debug(1, "Snapshot of slot %d taken in %d ms (%d bytes, %d bytes used by %d snapshots)",
+		slot, _system->getMillis() - startTime, _snapshots->getSize(0),
+		_snapshots->getMemoryUsage(), _snapshots->size());
+	return true;
+}
+
+void ScummEngine::flushSnapshot() {
+	if (!_snapshots || !_snapshots->isPending())
+		return;
+
+	Common::String filename = makeSavegameName(_snapshots->getSlot(0), true);
+	Common::OutSaveFile *out = _saveFileMan->openForSaving(filename);
+	bool success = out && _snapshots->writeNewest(out);
+	if (out) {
+		out->finalize();
+		success = success && !out->err();
+		delete out;
+	}
+
+	if (!success) {
+		warning("Could not write temporary state '%s'", filename.c_str());
+		return;
+	}
+	debug(1, "State saved as '%s'", filename.c_str());
+
+	_snapshots->setPending(false);
+}
+
 
 void ScummEngine_v4::prepareSavegame() {
 	Common::MemoryWriteStreamDynamic *memStream;
@@ -318,7 +393,18 @@ bool ScummEngine::loadState(int slot, bool compat) {
 	} else {
 		filename = makeSavegameName(slot, compat);
 	}
-	if (!(in = _saveFileMan->openForLoading(filename)))
+
+	// Prefer the in-memory copy of temporary states. It is at least as
+	// recent as the one on disk, which it replaces once flushed.
+	in = 0;
+	if (compat && _saveLoadSlot != 255 && _snapshots) {
+		int age = _saveLoadSnapshot >= 0 ? _saveLoadSnapshot : _snapshots->find(slot);
+		if (age >= 0)
+			in = _snapshots->open(age);
+	}
+	_saveLoadSnapshot = -1;
+
+	if (!in && !(in = _saveFileMan->openForLoading(filename)))
 		return false;
 
 	if (!loadSaveGameHeader(in, hdr)) {
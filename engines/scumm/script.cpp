@@ -27,6 +27,7 @@
 #include "scumm/actor.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
 #include "scumm/util.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v2.h"
@@ -489,9 +490,14 @@ void ScummEngine::executeScript() {
 }
 
 void ScummEngine::executeOpcode(byte i) {
-	if (_opcodes[i].proc && _opcodes[i].proc->isValid())
-		(*_opcodes[i].proc)();
-	else {
+	if (_opcodes[i].proc && _opcodes[i].proc->isValid()) {
+		if (_scriptProfiler && _scriptProfiler->getMode() != ScriptProfiler::kModeOff) {
+			_scriptProfiler->enterOpcode(_currentRoom, vm.slot[_currentScript].number, i);
+			(*_opcodes[i].proc)();
+			_scriptProfiler->leaveOpcode();
+		} else
+			(*_opcodes[i].proc)();
+	} else {
 		error("Invalid opcode '%x' at %lx", i, (long)(_scriptPointer - _scriptOrgPointer));
 	}
 }
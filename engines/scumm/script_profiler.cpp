@@ -0,0 +1,204 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "scumm/script_profiler.h"
+#include "scumm/scumm.h"
+
+namespace Scumm {
+
+ScriptProfiler::Node::~Node() {
+	for (Common::HashMap<uint32, Node *>::iterator i = children.begin(); i != children.end(); ++i)
+		delete i->_value;
+}
+
+ScriptProfiler::Node *ScriptProfiler::Node::getChild(uint32 key) {
+	Node *&child = children[key];
+	if (!child)
+		child = new Node();
+	return child;
+}
+
+ScriptProfiler::ScriptProfiler(ScummEngine *vm)
+	: _vm(vm), _mode(kModeOff), _root(new Node()), _depth(0), _room(0), _overflow(0), _lastSample(0) {
+}
+
+ScriptProfiler::~ScriptProfiler() {
+	delete _root;
+}
+
+void ScriptProfiler::setMode(Mode mode) {
+	_mode = mode;
+	_depth = 0;
+	_overflow = 0;
+	_lastSample = g_system->getMillis();
+}
+
+void ScriptProfiler::reset() {
+	delete _root;
+	_root = new Node();
+	_depth = 0;
+	_overflow = 0;
+	_lastSample = g_system->getMillis();
+}
+
+void ScriptProfiler::enterOpcode(int room, int script, byte opcode) {
+	if (_mode == kModeOff)
+		return;
+
+	if (_depth == kMaxDepth) {
+		_overflow++;
+		return;
+	}
+
+	const uint32 now = g_system->getMillis();
+	if (_depth == 0)
+		_room = room;
+
+	Frame &frame = _stack[_depth];
+	frame.key = (script << 8) | opcode;
+	frame.start = now;
+	frame.childTime = 0;
+	frame.node = NULL;
+
+	if (_mode == kModeFull) {
+		Node *parent = _depth ? _stack[_depth - 1].node : _root->getChild(kRoomKey | _room);
+		frame.node = parent->getChild(frame.key);
+		frame.node->calls++;
+	} else if (_depth == 0) {
+		// Time between two top level opcodes is not spent in scripts
+		_lastSample = now;
+	} else {
+		sample(now);
+	}
+
+	_depth++;
+}
+
+void ScriptProfiler::leaveOpcode() {
+	if (_overflow) {
+		_overflow--;
+		return;
+	}
+	if (_mode == kModeOff || _depth == 0)
+		return;
+
+	const uint32 now = g_system->getMillis();
+
+	if (_mode == kModeFull) {
+		Frame &frame = _stack[_depth - 1];
+		const uint32 total = now - frame.start;
+		if (total > frame.childTime)
+			frame.node->elapsed += total - frame.childTime;
+		if (_depth > 1)
+			_stack[_depth - 2].childTime += total;
+	} else {
+		sample(now);
+	}
+
+	_depth--;
+}
+
+void ScriptProfiler::sample(uint32 now) {
+	if (now == _lastSample)
+		return;
+
+	Node *node = _root->getChild(kRoomKey | _room);
+	for (int i = 0; i < _depth; i++)
+		node = node->getChild(_stack[i].key);
+	node->elapsed += now - _lastSample;
+
+	_lastSample = now;
+}
+
+void ScriptProfiler::getOpcodeTotals(Totals totals[256]) const {
+	memset(totals, 0, 256 * sizeof(Totals));
+	sumNode(_root, 0, 0, totals, NULL, NULL);
+}
+
+void ScriptProfiler::getScriptTotals(Common::HashMap<uint32, Totals> &totals) const {
+	totals.clear();
+	sumNode(_root, 0, 0, NULL, &totals, NULL);
+}
+
+void ScriptProfiler::getRoomTotals(Common::HashMap<uint32, Totals> &totals) const {
+	totals.clear();
+	sumNode(_root, 0, 0, NULL, NULL, &totals);
+}
+
+void ScriptProfiler::sumNode(const Node *node, uint32 key, uint32 room, Totals *opcodes, Common::HashMap<uint32, Totals> *scripts, Common::HashMap<uint32, Totals> *rooms) const {
+	if (key & kRoomKey) {
+		room = key & ~kRoomKey;
+	} else if (node != _root) {
+		Totals *t[3] = { NULL, NULL, NULL };
+
+		if (opcodes)
+			t[0] = &opcodes[key & 0xFF];
+		if (scripts) {
+			if (!scripts->contains(key >> 8))
+				memset(&(*scripts)[key >> 8], 0, sizeof(Totals));
+			t[1] = &(*scripts)[key >> 8];
+		}
+		if (rooms) {
+			if (!rooms->contains(room))
+				memset(&(*rooms)[room], 0, sizeof(Totals));
+			t[2] = &(*rooms)[room];
+		}
+
+		for (int i = 0; i < 3; i++) {
+			if (t[i]) {
+				t[i]->calls += node->calls;
+				t[i]->elapsed += node->elapsed;
+			}
+		}
+	}
+
+	for (Common::HashMap<uint32, Node *>::const_iterator i = node->children.begin(); i != node->children.end(); ++i)
+		sumNode(i->_value, i->_key, room, opcodes, scripts, rooms);
+}
+
+void ScriptProfiler::writeCollapsed(Common::WriteStream &out) const {
+	for (Common::HashMap<uint32, Node *>::const_iterator i = _root->children.begin(); i != _root->children.end(); ++i)
+		writeNode(out, i->_value, describeKey(i->_key));
+}
+
+void ScriptProfiler::writeNode(Common::WriteStream &out, const Node *node, const Common::String &path) const {
+	if (node->elapsed)
+		out.writeString(Common::String::format("%s %d\n", path.c_str(), node->elapsed));
+
+	for (Common::HashMap<uint32, Node *>::const_iterator i = node->children.begin(); i != node->children.end(); ++i)
+		writeNode(out, i->_value, path + ";" + describeKey(i->_key));
+}
+
+Common::String ScriptProfiler::describeKey(uint32 key) const {
+	if (key & kRoomKey)
+		return Common::String::format("room-%d", key & ~kRoomKey);
+
+	const char *desc = _vm->getOpcodeDesc(key & 0xFF);
+	if (desc && *desc)
+		return Common::String::format("script-%d;%s", key >> 8, desc);
+	return Common::String::format("script-%d;opcode-%02x", key >> 8, key & 0xFF);
+}
+
+} // End of namespace Scumm
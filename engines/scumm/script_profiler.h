@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_SCRIPT_PROFILER_H
+#define SCUMM_SCRIPT_PROFILER_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+
+namespace Common {
+class WriteStream;
+}
+
+namespace Scumm {
+
+class ScummEngine;
+
+/**
+ * Profiler for the script VM.
+ *
+ * Every executed opcode is recorded in a call tree, with the room at
+ * the root and one node per (script, opcode) pair below it. Opcodes
+ * which run nested scripts get those as children, so the tree can be
+ * written out as collapsed stacks for flame graph tools.
+ *
+ * In full mode every opcode is counted and timed. Timing uses the
+ * millisecond clock, so short opcodes are charged whenever a clock
+ * tick falls inside them, which averages out over a long run. In
+ * sampling mode only the call stack is maintained, and the current
+ * stack is charged once per elapsed millisecond.
+ */
+class ScriptProfiler {
+public:
+	enum Mode {
+		kModeOff,
+		kModeFull,
+		kModeSampling
+	};
+
+	struct Totals {
+		uint32 calls;
+		uint32 elapsed;	///< Milliseconds in full mode, samples otherwise
+	};
+
+	ScriptProfiler(ScummEngine *vm);
+	~ScriptProfiler();
+
+	Mode getMode() const { return _mode; }
+	void setMode(Mode mode);
+	void reset();
+
+	void enterOpcode(int room, int script, byte opcode);
+	void leaveOpcode();
+
+	/** Sum self time and calls over the whole tree. */
+	void getOpcodeTotals(Totals totals[256]) const;
+	void getScriptTotals(Common::HashMap<uint32, Totals> &totals) const;
+	void getRoomTotals(Common::HashMap<uint32, Totals> &totals) const;
+
+	/** Write the call tree as collapsed stacks, one line per node. */
+	void writeCollapsed(Common::WriteStream &out) const;
+
+private:
+	struct Node {
+		uint32 calls;
+		uint32 elapsed;
+		Common::HashMap<uint32, Node *> children;
+
+		Node() : calls(0), elapsed(0) {}
+		~Node();
+
+		Node *getChild(uint32 key);
+	};
+
+	struct Frame {
+		Node *node;
+		uint32 key;
+		uint32 start;
+		uint32 childTime;
+	};
+
+	enum {
+		kMaxDepth = 64,
+		kRoomKey = 0x80000000
+	};
+
+	ScummEngine *_vm;
+	Mode _mode;
+	Node *_root;
+
+	Frame _stack[kMaxDepth];
+	int _depth;
+	int _room;				///< Room the outermost frame was entered in
+	int _overflow;			///< Frames not pushed because the stack was full
+	uint32 _lastSample;
+
+	void sample(uint32 now);
+	void sumNode(const Node *node, uint32 key, uint32 room, Totals *opcodes, Common::HashMap<uint32, Totals> *scripts, Common::HashMap<uint32, Totals> *rooms) const;
+	void writeNode(Common::WriteStream &out, const Node *node, const Common::String &path) const;
+	Common::String describeKey(uint32 key) const;
+};
+
+} // End of namespace Scumm
+
+#endif
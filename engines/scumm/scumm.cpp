@@ -66,8 +66,10 @@
 #include "scumm/player_v5m.h"
 #include "scumm/resource.h"
 #include "scumm/he/resource_he.h"
+#include "scumm/script_profiler.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v8.h"
+#include "scumm/snapshot.h"
 #include "scumm/sound.h"
 #include "scumm/imuse/sysex.h"
 #include "scumm/he/sprite_he.h"
@@ -121,7 +123,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	  _game(dr.game),
 	  _filenamePattern(dr.fp),
 	  _language(dr.language),
-	  _debugger(0),
+	  _debugger(0), _scriptProfiler(0),
 	  _currentScript(0xFF), // Let debug() work on init stage
 	  _messageDialog(0), _pauseDialog(0), _versionDialog(0),
 	  _rnd("scumm")
@@ -224,6 +226,8 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_saveLoadSlot = 0;
 	_lastSaveTime = 0;
 	_saveTemporaryState = false;
+	_snapshots = NULL;
+	_saveLoadSnapshot = -1;
 	memset(_localScriptOffsets, 0, sizeof(_localScriptOffsets));
 	_scriptPointer = NULL;
 	_scriptOrgPointer = NULL;
@@ -650,6 +654,10 @@ ScummEngine::~ScummEngine() {
 #endif
 
 	delete _debugger;
+	delete _scriptProfiler;
+
+	flushSnapshot();
+	delete _snapshots;
 
 	delete _res;
 	delete _gdi;
@@ -88,7 +88,9 @@ class MusicEngine;
 class Player_Towns;
 class ScummEngine;
 class ScummDebugger;
+class ScriptProfiler;
 class Serializer;
+class SnapshotRing;
 class Sound;
 
 struct Box;
@@ -367,6 +369,7 @@ class ResourceManager;
  */
 class ScummEngine : public Engine {
 	friend class ScummDebugger;
+	friend class ScriptProfiler;
 	friend class CharsetRenderer;
 	friend class CharsetRendererTownsClassic;
 	friend class ResourceManager;
@@ -384,6 +387,7 @@ public:
 	VerbSlot *_verbs;
 	ObjectData *_objs;
 	ScummDebugger *_debugger;
+	ScriptProfiler *_scriptProfiler;
 
 	// Core variables
 	GameSettings _game;
@@ -596,9 +600,14 @@ protected:
 	Common::String _saveLoadFileName;
 	Common::String _saveLoadDescription;
 
+	SnapshotRing *_snapshots;	///< Temporary save states kept in memory
+	int _saveLoadSnapshot;		///< Snapshot to restore on the next load, or -1
+
 	bool saveState(Common::OutSaveFile *out, bool writeHeader = true);
 	bool saveState(int slot, bool compat);
 	bool loadState(int slot, bool compat);
+	bool saveSnapshot(int slot);
+	void flushSnapshot();
 	virtual void saveOrLoad(Serializer *s);
 	void saveResource(Serializer *ser, ResType type, ResId idx);
 	void loadResource(Serializer *ser, ResType type, ResId idx);
@@ -618,6 +627,7 @@ public:
 
 	void requestSave(int slot, const Common::String &name);
 	void requestLoad(int slot);
+	void requestSnapshotLoad(int age);
 
 // thumbnail + info stuff
 public:
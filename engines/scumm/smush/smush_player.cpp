@@ -24,6 +24,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 
@@ -241,9 +242,17 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm) {
 	_paused = false;
 	_pauseStartTime = 0;
 	_pauseTime = 0;
+	_frameChunk = NULL;
+	_frameChunkSize = 0;
+	resetStats();
 }
 
 SmushPlayer::~SmushPlayer() {
+	free(_frameChunk);
+}
+
+void SmushPlayer::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 void SmushPlayer::init(int32 speed) {
@@ -1030,9 +1039,22 @@ void SmushPlayer::parseNextFrame() {
 	case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
 		handleAnimHeader(subSize, *_base);
 		break;
-	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
+	case MKTAG('F','R','M','E'): {
+		// Pull in the whole frame with a single read, so the many small
+		// sub chunk reads below are served from memory instead of the
+		// (possibly bundled) file.
+		if ((uint32)subSize > _frameChunkSize) {
+			free(_frameChunk);
+			_frameChunk = (byte *)malloc(subSize);
+			assert(_frameChunk);
+			_frameChunkSize = subSize;
+		}
+		_base->read(_frameChunk, subSize);
+
+		Common::MemoryReadStream frame(_frameChunk, subSize);
+		handleFrame(subSize, frame);
 		break;
+	}
 	default:
 		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
 	}
@@ -1203,7 +1225,11 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 				skipFrame = true;
 			else
 				skipFrame = false;
+
+			uint32 decodeStart = _vm->_system->getMillis();
 			timerCallback();
+			_stats.framesDecoded++;
+			_stats.maxDecodeTime = MAX(_stats.maxDecodeTime, _vm->_system->getMillis() - decodeStart);
 		}
 
 		_vm->scummLoop_handleSound();
@@ -1238,10 +1264,15 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 				_vm->_system->copyRectToScreen(_dst, _width, 0, 0, w, h);
 				_vm->_system->updateScreen();
 				_updateNeeded = false;
+				_stats.framesShown++;
 			}
 		}
 		if (_endOfFile)
 			break;
+		// This port cannot block in here, so the player always returns after
+		// one pass. Frames are therefore never decoded behind the timer, and
+		// neither skipping to catch up nor dropped frame statistics are
+		// possible until the player is driven from the browser main loop.
 		if (true || _vm->shouldQuit() || _vm->_saveLoadFlag || _vm->_smushVideoShouldFinish) {
 			_smixer->stop();
 			_vm->_mixer->stopHandle(_compressedFileSoundHandle);
@@ -37,6 +37,14 @@ class Codec47Decoder;
 
 class SmushPlayer {
 	friend class Insane;
+public:
+	/** Playback statistics, accumulated over all movies played. */
+	struct Stats {
+		uint32 framesDecoded;  ///< FRME chunks handled
+		uint32 framesShown;    ///< Frames copied to the screen
+		uint32 maxDecodeTime;  ///< Slowest frame decode, in ms
+	};
+
 private:
 	ScummEngine_v7 *_vm;
 	int32 _nbframes;
@@ -82,6 +90,11 @@ private:
 	bool _middleAudio;
 	bool _skipPalette;
 
+	byte *_frameChunk;
+	uint32 _frameChunkSize;
+
+	Stats _stats;
+
 public:
 	SmushPlayer(ScummEngine_v7 *scumm);
 	~SmushPlayer();
@@ -93,6 +106,9 @@ public:
 	void release();
 	void warpMouse(int x, int y, int buttons);
 
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+
 protected:
 	int _width, _height;
 
@@ -0,0 +1,238 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+#include "scumm/snapshot.h"
+
+namespace Scumm {
+
+// A delta is a sequence of (skip, length, bytes) records. Each record
+// skips a run of unchanged bytes and then XORs the given bytes into the
+// data. Changed bytes separated by fewer than kMinSkip unchanged ones are
+// merged into one record, as a new record would not be any shorter.
+enum {
+	kMinSkip = 4
+};
+
+uint32 SnapshotRing::Arena::write(const void *dataPtr, uint32 dataSize) {
+	if (_size + dataSize > _capacity) {
+		uint32 capacity = MAX<uint32>(_capacity * 2, 4096);
+		while (capacity < _size + dataSize)
+			capacity *= 2;
+
+		byte *data = (byte *)realloc(_data, capacity);
+		if (!data) {
+			_err = true;
+			return 0;
+		}
+		_data = data;
+		_capacity = capacity;
+	}
+
+	memcpy(_data + _size, dataPtr, dataSize);
+	_size += dataSize;
+	return dataSize;
+}
+
+void SnapshotRing::Arena::writeVarint(uint32 value) {
+	while (value >= 0x80) {
+		writeByte((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	writeByte(value);
+}
+
+static uint32 readVarint(const byte *&src) {
+	uint32 value = 0;
+	int shift = 0;
+	byte b;
+	do {
+		b = *src++;
+		value |= (b & 0x7F) << shift;
+		shift += 7;
+	} while (b & 0x80);
+	return value;
+}
+
+SnapshotRing::SnapshotRing(uint maxCount) : _maxCount(MAX<uint>(maxCount, 1)), _pending(false) {
+}
+
+SnapshotRing::~SnapshotRing() {
+	clear();
+}
+
+void SnapshotRing::clear() {
+	for (uint i = 0; i < _entries.size(); ++i)
+		free(_entries[i].delta);
+	_entries.clear();
+	_latest.reset();
+	_pending = false;
+}
+
+Common::WriteStream *SnapshotRing::beginSnapshot() {
+	_arena.reset();
+	return &_arena;
+}
+
+void SnapshotRing::commitSnapshot(int slot) {
+	if (!_entries.empty()) {
+		// Turn the current newest snapshot into a delta against the new one
+		Entry &prev = _entries[0];
+		encodeDelta(_latest._data, _latest._size, _arena._data, _arena._size);
+		prev.deltaSize = _scratch._size;
+		prev.delta = _scratch.err() ? 0 : (byte *)malloc(prev.deltaSize ? prev.deltaSize : 1);
+		if (prev.delta) {
+			memcpy(prev.delta, _scratch._data, prev.deltaSize);
+		} else {
+			// Without the delta the older snapshots cannot be restored
+			warning("SnapshotRing: Out of memory, dropping %d older snapshots", _entries.size());
+			for (uint i = 1; i < _entries.size(); ++i)
+				free(_entries[i].delta);
+			_entries.clear();
+		}
+	}
+
+	// The arena becomes the newest snapshot, and the old copy of the
+	// newest snapshot becomes the arena for the next one.
+	SWAP(_latest._data, _arena._data);
+	SWAP(_latest._size, _arena._size);
+	SWAP(_latest._capacity, _arena._capacity);
+
+	Entry entry;
+	entry.slot = slot;
+	entry.size = _latest._size;
+	entry.delta = 0;
+	entry.deltaSize = 0;
+	_entries.insert_at(0, entry);
+
+	while (_entries.size() > _maxCount) {
+		free(_entries.back().delta);
+		_entries.pop_back();
+	}
+}
+
+int SnapshotRing::find(int slot) const {
+	for (uint i = 0; i < _entries.size(); ++i) {
+		if (_entries[i].slot == slot)
+			return i;
+	}
+	return -1;
+}
+
+uint32 SnapshotRing::getStoredSize(uint age) const {
+	return age ? _entries[age].deltaSize : _latest._size;
+}
+
+uint32 SnapshotRing::getMemoryUsage() const {
+	uint32 total = _latest._capacity + _arena._capacity + _scratch._capacity;
+	for (uint i = 1; i < _entries.size(); ++i)
+		total += _entries[i].deltaSize;
+	return total;
+}
+
+Common::SeekableReadStream *SnapshotRing::open(uint age) const {
+	if (age >= _entries.size())
+		return 0;
+
+	uint32 maxSize = _latest._size;
+	for (uint i = 1; i <= age; ++i)
+		maxSize = MAX(maxSize, _entries[i].size);
+
+	byte *data = (byte *)malloc(maxSize ? maxSize : 1);
+	if (!data)
+		return 0;
+	memcpy(data, _latest._data, _latest._size);
+
+	// Deltas treat the newer state as zero padded to the older size
+	uint32 size = _latest._size;
+	for (uint i = 1; i <= age; ++i) {
+		const Entry &entry = _entries[i];
+		if (entry.size > size)
+			memset(data + size, 0, entry.size - size);
+		applyDelta(data, entry.delta, entry.deltaSize);
+		size = entry.size;
+	}
+
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+bool SnapshotRing::writeNewest(Common::WriteStream *out) const {
+	if (_entries.empty())
+		return false;
+	return out->write(_latest._data, _latest._size) == _latest._size;
+}
+
+void SnapshotRing::encodeDelta(const byte *oldData, uint32 oldSize, const byte *newData, uint32 newSize) {
+	_scratch.reset();
+
+#define XOR_AT(i) (oldData[i] ^ ((i) < newSize ? newData[i] : 0))
+
+	uint32 pos = 0;
+	while (pos < oldSize) {
+		const uint32 skipStart = pos;
+		while (pos < oldSize && !XOR_AT(pos))
+			++pos;
+		if (pos == oldSize)
+			break;
+
+		// Extend the record until the next long enough unchanged run
+		const uint32 start = pos;
+		uint32 end = pos;
+		while (end < oldSize) {
+			if (XOR_AT(end)) {
+				++end;
+				continue;
+			}
+
+			uint32 next = end;
+			while (next < oldSize && !XOR_AT(next) && next - end < kMinSkip)
+				++next;
+			if (next == oldSize || next - end >= kMinSkip)
+				break;
+			end = next;
+		}
+
+		_scratch.writeVarint(start - skipStart);
+		_scratch.writeVarint(end - start);
+		for (uint32 i = start; i < end; ++i)
+			_scratch.writeByte(XOR_AT(i));
+		pos = end;
+	}
+
+#undef XOR_AT
+}
+
+void SnapshotRing::applyDelta(byte *data, const byte *delta, uint32 deltaSize) {
+	const byte *src = delta;
+	const byte *srcEnd = delta + deltaSize;
+
+	while (src < srcEnd) {
+		data += readVarint(src);
+		uint32 len = readVarint(src);
+		while (len--)
+			*data++ ^= *src++;
+	}
+}
+
+} // End of namespace Scumm
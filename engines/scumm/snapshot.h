@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_SNAPSHOT_H
+#define SCUMM_SNAPSHOT_H
+
+#include "common/array.h"
+#include "common/stream.h"
+
+namespace Scumm {
+
+/**
+ * In-memory ring of temporary save states.
+ *
+ * Games save and restore temporary states around many cutscenes, so
+ * these are kept in memory instead of going through the save file
+ * manager each time. The newest snapshot is stored in full; every older
+ * one is stored as a run-length coded XOR delta against the snapshot
+ * which followed it, so restoring one walks the deltas back from the
+ * newest. Consecutive states of the same game differ in few bytes, which
+ * keeps a ring of several snapshots not much larger than a single one.
+ *
+ * States are serialized into a reusable arena. Writing the newest one to
+ * disk is left to the engine, which only does so when it can no longer
+ * be avoided (see ScummEngine::flushSnapshot()).
+ */
+class SnapshotRing {
+public:
+	enum {
+		kDefaultCount = 8
+	};
+
+	SnapshotRing(uint maxCount = kDefaultCount);
+	~SnapshotRing();
+
+	/** Drop all snapshots. */
+	void clear();
+
+	/**
+	 * Start a new snapshot. The returned stream stays owned by the ring
+	 * and is valid until commitSnapshot() is called.
+	 */
+	Common::WriteStream *beginSnapshot();
+
+	/** Make the data written since beginSnapshot() the newest snapshot. */
+	void commitSnapshot(int slot);
+
+	/** Number of snapshots in the ring. */
+	uint size() const { return _entries.size(); }
+
+	/** Age of the newest snapshot saved to the given slot, or -1. */
+	int find(int slot) const;
+
+	int getSlot(uint age) const { return _entries[age].slot; }
+	uint32 getSize(uint age) const { return _entries[age].size; }
+
+	/** Bytes used to store the given snapshot. */
+	uint32 getStoredSize(uint age) const;
+
+	/** Total bytes allocated by the ring, including its arena. */
+	uint32 getMemoryUsage() const;
+
+	/** Open a snapshot for reading; 0 is the newest one. */
+	Common::SeekableReadStream *open(uint age) const;
+
+	/** Write the newest snapshot to a stream. */
+	bool writeNewest(Common::WriteStream *out) const;
+
+	/** Whether the newest snapshot has not been written to disk yet. */
+	bool isPending() const { return !_entries.empty() && _pending; }
+	void setPending(bool pending) { _pending = pending; }
+
+private:
+	/** Growable buffer which keeps its memory between snapshots. */
+	class Arena : public Common::WriteStream {
+	public:
+		Arena() : _data(0), _size(0), _capacity(0), _err(false) {}
+		~Arena() { free(_data); }
+
+		void reset() { _size = 0; _err = false; }
+		uint32 write(const void *dataPtr, uint32 dataSize);
+		void writeVarint(uint32 value);
+		uint32 pos() const { return _size; }
+		bool err() const { return _err; }
+		void clearErr() { _err = false; }
+
+		byte *_data;
+		uint32 _size;
+		uint32 _capacity;
+		bool _err;		///< Growing the buffer failed
+	};
+
+	struct Entry {
+		int slot;
+		uint32 size;		///< Size of the serialized state
+		byte *delta;		///< Delta against the next newer entry, 0 for the newest
+		uint32 deltaSize;
+	};
+
+	void encodeDelta(const byte *oldData, uint32 oldSize, const byte *newData, uint32 newSize);
+	static void applyDelta(byte *data, const byte *delta, uint32 deltaSize);
+
+	uint _maxCount;
+	Common::Array<Entry> _entries;	///< Newest first
+	Arena _latest;		///< Full copy of the newest snapshot
+	Arena _arena;		///< Snapshot being written
+	Arena _scratch;		///< Delta being encoded
+	bool _pending;
+};
+
+} // End of namespace Scumm
+
+#endif
@@ -22,14 +22,41 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/resmanager.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	DCmd_Register("resources", WRAP_METHOD(Sword25Console, Cmd_Resources));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_Resources(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "list"))) {
+		DebugPrintf("Usage: %s [list]\n", argv[0]);
+		return true;
+	}
+
+	ResourceManager *resourceManager = Kernel::getInstance()->getResourceManager();
+	const ResourceManager::Stats &stats = resourceManager->getStats();
+
+	if (argc == 2) {
+		DebugPrintf("   Bytes Ref File\n");
+		resourceManager->dumpResources(this);
+	}
+
+	DebugPrintf("Resources loaded: %u\n", resourceManager->getResourceCount());
+	DebugPrintf("Decoded bytes: %u of %u\n", resourceManager->getUsedMemory(), resourceManager->getMaxMemoryUsage());
+	DebugPrintf("Requests: %u hits, %u misses\n", stats.hits, stats.misses);
+	DebugPrintf("Prefetched: %u, %u queued\n", stats.prefetches, resourceManager->getPrefetchQueueSize());
+	DebugPrintf("Evicted: %u\n", stats.evictions);
+
+	return true;
+}
+
 } // End of namespace Sword25
@@ -60,6 +60,9 @@ enum {
 
 namespace Sword25 {
 
+// Time in milliseconds spent on loading prefetched resources after each frame
+static const uint32 PREFETCH_TIME = 5;
+
 static const uint FRAMETIME_SAMPLE_COUNT = 5;       // Anzahl der Framezeiten ber die, die Framezeit gemittelt wird
 
 GraphicEngine::GraphicEngine(Kernel *pKernel) :
@@ -148,6 +151,8 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	Kernel::getInstance()->getResourceManager()->prefetchResources(PREFETCH_TIME);
+
 	return true;
 }
 
@@ -208,6 +208,11 @@ public:
 	
 	virtual bool isSolid() const { return false; }
 
+	/**
+	    @brief Returns the number of bytes of decoded pixel data held by the image.
+	*/
+	virtual uint getMemoryUsage() const { return 0; }
+
 	//@}
 };
 
@@ -109,6 +109,10 @@ public:
 	void setIsTransparent(bool isTransparent) { _isTransparent = isTransparent; }
 	virtual bool isSolid() const { return !_isTransparent; }
 
+	virtual uint getMemoryUsage() const {
+		return _doCleanup ? _width * _height * 4 : 0;
+	}
+
 private:
 	byte *_data;
 	int  _width;
@@ -85,6 +85,9 @@ public:
 	virtual bool isSetContentAllowed() const        {
 		return false;
 	}
+	virtual uint getMemoryUsage() const {
+		return _width * _height * sizeof(uint);
+	}
 private:
 	uint *_imageDataPtr;
 
@@ -43,6 +43,9 @@ namespace Sword25 {
 
 #define BEZSMOOTHNESS 0.5
 
+// Bytes of memory the rasterized versions of all vector images may use together
+#define RASTER_CACHE_BUDGET (8 * 1024 * 1024)
+
 // -----------------------------------------------------------------------------
 // SWF datatype
 // -----------------------------------------------------------------------------
@@ -215,9 +218,18 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage *VectorImage::_firstImage = 0;
+uint32 VectorImage::_rasterCacheSize = 0;
+uint32 VectorImage::_rasterTick = 0;
+
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) :
+	_fname(fname), _flattened(false), _prevImage(0), _nextImage(_firstImage) {
 	success = false;
 
+	if (_firstImage)
+		_firstImage->_prevImage = this;
+	_firstImage = this;
+
 	// Create bitstream object
 	// In the following the file data will be readout of the bitstream object.
 	SWFBitStream bs(pFileData, fileSize);
@@ -300,8 +312,20 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	if (_pixelData)
-		free(_pixelData);
+	for (uint i = 0; i < _shapes.size(); i++)
+		free(_shapes[i].vec);
+
+	for (uint i = 0; i < _rasters.size(); i++) {
+		_rasterCacheSize -= _rasters[i].width * _rasters[i].height * 4;
+		free(_rasters[i].pixels);
+	}
+
+	if (_prevImage)
+		_prevImage->_nextImage = _nextImage;
+	else
+		_firstImage = _nextImage;
+	if (_nextImage)
+		_nextImage->_prevImage = _prevImage;
 }
 
 
@@ -605,26 +629,13 @@ bool VectorImage::blit(int posX, int posY,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
-
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
-	}
-
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(getRaster(width, height), width, height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
@@ -632,4 +643,59 @@ bool VectorImage::blit(int posX, int posY,
 	return true;
 }
 
+uint VectorImage::getMemoryUsage() const {
+	uint size = 0;
+	for (uint i = 0; i < _rasters.size(); i++)
+		size += _rasters[i].width * _rasters[i].height * 4;
+	return size;
+}
+
+byte *VectorImage::getRaster(int width, int height) {
+	for (uint i = 0; i < _rasters.size(); i++) {
+		if (_rasters[i].width == width && _rasters[i].height == height) {
+			_rasters[i].lastUse = ++_rasterTick;
+			return _rasters[i].pixels;
+		}
+	}
+
+	Raster raster;
+	raster.width = width;
+	raster.height = height;
+	raster.pixels = render(width, height);
+	raster.lastUse = ++_rasterTick;
+	_rasters.push_back(raster);
+	_rasterCacheSize += width * height * 4;
+
+	trimRasterCache(raster.pixels);
+
+	return raster.pixels;
+}
+
+void VectorImage::trimRasterCache(const byte *keep) {
+	while (_rasterCacheSize > RASTER_CACHE_BUDGET) {
+		VectorImage *oldestImage = 0;
+		uint oldest = 0;
+
+		for (VectorImage *image = _firstImage; image; image = image->_nextImage) {
+			for (uint i = 0; i < image->_rasters.size(); i++) {
+				if (image->_rasters[i].pixels == keep)
+					continue;
+				if (!oldestImage || image->_rasters[i].lastUse < oldestImage->_rasters[oldest].lastUse) {
+					oldestImage = image;
+					oldest = i;
+				}
+			}
+		}
+
+		// The raster which is about to be drawn always stays
+		if (!oldestImage)
+			break;
+
+		Raster &raster = oldestImage->_rasters[oldest];
+		_rasterCacheSize -= raster.width * raster.height * 4;
+		free(raster.pixels);
+		oldestImage->_rasters.remove_at(oldest);
+	}
+}
+
 } // End of namespace Sword25
@@ -183,7 +183,11 @@ public:
 	}
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	    @brief Rasterizes the image at the given size.
+	    @return a newly allocated ARGB buffer of width * height pixels, which the caller has to free()
+	*/
+	byte *render(int width, int height);
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -208,6 +212,7 @@ public:
 		return false;
 	}
 	virtual bool setContent(const byte *pixeldata, uint size, uint offset, uint stride);
+	virtual uint getMemoryUsage() const;
 	virtual bool blit(int posX = 0, int posY = 0,
 	                  int flipping = FLIP_NONE,
 	                  Common::Rect *pPartRect = NULL,
@@ -225,9 +230,50 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
-
 	Common::String _fname;
+
+	/**
+	    @brief A fill or stroke of the image, with its Bezier curves already flattened.
+
+	    Flattening happens in image coordinates, so the polygons only have to be scaled
+	    when the image is rasterized at another size.
+	*/
+	struct FlatShape {
+		ArtVpath *vec;
+		bool isFill;
+		double penWidth;
+		uint32 color;
+	};
+
+	void flatten();
+
+	Common::Array<FlatShape> _shapes;
+	bool _flattened;
+
+	/**
+	    @brief A rasterized version of the image.
+
+	    The rasters of all vector images share a memory budget of RASTER_CACHE_BUDGET bytes.
+	    When it is exceeded, the least recently used rasters are discarded.
+	*/
+	struct Raster {
+		int width;
+		int height;
+		byte *pixels;
+		uint32 lastUse;
+	};
+
+	byte *getRaster(int width, int height);
+	static void trimRasterCache(const byte *keep);
+
+	Common::Array<Raster> _rasters;
+
+	// All vector images, so rasters can be evicted across images
+	VectorImage *_prevImage;
+	VectorImage *_nextImage;
+	static VectorImage *_firstImage;
+	static uint32 _rasterCacheSize;
+	static uint32 _rasterTick;
 };
 
 } // End of namespace Sword25
@@ -333,35 +333,25 @@ ArtVpath *art_vpath_reverse_free(ArtVpath *a) {
 	return dest;
 }
 
-void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height, int deltaX, int deltaY, double scaleX, double scaleY, double penWidth, unsigned int color) {
+static ArtVpath *flattenBez(ArtBpath *bez1, ArtBpath *bez2) {
 	ArtVpath *vec = NULL;
 	ArtVpath *vec1 = NULL;
 	ArtVpath *vec2 = NULL;
-	ArtSVP *svp = NULL;
 
 #if 0
 	const char *codes[] = {"ART_MOVETO", "ART_MOVETO_OPEN", "ART_CURVETO", "ART_LINETO", "ART_END"};
 	for (int i = 0;; i++) {
-		debugN("    bez[%d].code = %s;\n", i, codes[bez[i].code]);
-		if (bez[i].code == ART_END)
+		debugN("    bez[%d].code = %s;\n", i, codes[bez1[i].code]);
+		if (bez1[i].code == ART_END)
 			break;
-		if (bez[i].code == ART_CURVETO) {
-			debugN("    bez[%d].x1 = %f; bez[%d].y1 = %f;\n", i, bez[i].x1, i, bez[i].y1);
-			debugN("    bez[%d].x2 = %f; bez[%d].y2 = %f;\n", i, bez[i].x2, i, bez[i].y2);
+		if (bez1[i].code == ART_CURVETO) {
+			debugN("    bez[%d].x1 = %f; bez[%d].y1 = %f;\n", i, bez1[i].x1, i, bez1[i].y1);
+			debugN("    bez[%d].x2 = %f; bez[%d].y2 = %f;\n", i, bez1[i].x2, i, bez1[i].y2);
 		}
-		debugN("    bez[%d].x3 = %f; bez[%d].y3 = %f;\n", i, bez[i].x3, i, bez[i].y3);
+		debugN("    bez[%d].x3 = %f; bez[%d].y3 = %f;\n", i, bez1[i].x3, i, bez1[i].y3);
 	}
-
-	debugN("    drawBez(bez, buffer, 1.0, 1.0, %f, 0x%08x);\n", penWidth, color);
 #endif
 
-	// HACK: Some frames have green bounding boxes drawn.
-	// Perhaps they were used by original game artist Umriss
-	// We skip them just like the original
-	if (bez2 == 0 && color == Graphics::ARGBToColor<Graphics::ColorMasks<8888> >(0xff, 0x00, 0xff, 0x00)) {
-		return;
-	}
-
 	vec1 = art_bez_path_to_vec(bez1, 0.5);
 	if (bez2 != 0) {
 		vec2 = art_bez_path_to_vec(bez2, 0.5);
@@ -374,10 +364,16 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 		vec = vec1;
 	}
 
+	return vec;
+}
+
+static void drawVec(ArtVpath *vec, bool isFill, byte *buffer, int width, int height, int deltaX, int deltaY, double scaleX, double scaleY, double penWidth, unsigned int color) {
+	ArtSVP *svp = NULL;
+
 	int size = art_vpath_len(vec);
 	ArtVpath *vect = art_new(ArtVpath, size + 1);
 	if (!vect)
-		error("[drawBez] Cannot allocate memory");
+		error("[drawVec] Cannot allocate memory");
 
 	int k;
 	for (k = 0; k < size; k++) {
@@ -387,7 +383,7 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 	}
 	vect[k].code = ART_END;
 
-	if (bez2 == 0) { // Line drawing
+	if (!isFill) { // Line drawing
 		svp = art_svp_vpath_stroke(vect, ART_PATH_STROKE_JOIN_ROUND, ART_PATH_STROKE_CAP_ROUND, penWidth, 1.0, 0.5);
 	} else {
 		svp = art_svp_from_vpath(vect);
@@ -398,24 +394,12 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 
 	free(vect);
 	art_svp_free(svp);
-	free(vec);
 }
 
-void VectorImage::render(int width, int height) {
-	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
-	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
-
-	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
-
-	if (_pixelData)
-		free(_pixelData);
-
-	_pixelData = (byte *)malloc(width * height * 4);
-	memset(_pixelData, 0, width * height * 4);
-
+void VectorImage::flatten() {
 	for (uint e = 0; e < _elements.size(); e++) {
 
-		//// Draw shapes
+		//// Shapes
 		for (uint s = 0; s < _elements[e].getFillStyleCount(); s++) {
 			int fill0len = 0;
 			int fill1len = 0;
@@ -452,24 +436,62 @@ void VectorImage::render(int width, int height) {
 			(*fill0pos).code = ART_END;
 			(*fill1pos).code = ART_END;
 
-			drawBez(fill1, fill0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
+			FlatShape shape;
+			shape.vec = flattenBez(fill1, fill0);
+			shape.isFill = true;
+			shape.penWidth = -1;
+			shape.color = _elements[e].getFillStyleColor(s);
+			_shapes.push_back(shape);
 
 			free(fill0);
 			free(fill1);
 		}
 
-		//// Draw strokes
+		//// Strokes
 		for (uint s = 0; s < _elements[e].getLineStyleCount(); s++) {
-			double penWidth = _elements[e].getLineStyleWidth(s);
-			penWidth *= sqrt(fabs(scaleX * scaleY));
+			// HACK: Some frames have green bounding boxes drawn.
+			// Perhaps they were used by original game artist Umriss
+			// We skip them just like the original
+			if (_elements[e].getLineStyleColor(s) == Graphics::ARGBToColor<Graphics::ColorMasks<8888> >(0xff, 0x00, 0xff, 0x00))
+				continue;
 
 			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
 				if (_elements[e].getPathInfo(p).getLineStyle() == s + 1) {
-					drawBez(_elements[e].getPathInfo(p).getVec(), 0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
+					FlatShape shape;
+					shape.vec = flattenBez(_elements[e].getPathInfo(p).getVec(), 0);
+					shape.isFill = false;
+					shape.penWidth = _elements[e].getLineStyleWidth(s);
+					shape.color = _elements[e].getLineStyleColor(s);
+					_shapes.push_back(shape);
 				}
 			}
 		}
 	}
+
+	_flattened = true;
+}
+
+byte *VectorImage::render(int width, int height) {
+	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
+	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
+
+	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
+
+	if (!_flattened)
+		flatten();
+
+	byte *pixelData = (byte *)malloc(width * height * 4);
+	memset(pixelData, 0, width * height * 4);
+
+	const double penScale = sqrt(fabs(scaleX * scaleY));
+
+	for (uint i = 0; i < _shapes.size(); i++) {
+		const FlatShape &shape = _shapes[i];
+		drawVec(shape.vec, shape.isFill, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY,
+		        shape.isFill ? shape.penWidth : shape.penWidth * penScale, shape.color);
+	}
+
+	return pixelData;
 }
 
 
@@ -129,9 +129,14 @@ static int getSubversionRevision(lua_State *L) {
 }
 
 static int getUsedMemory(lua_State *L) {
-	// It doesn't really matter what this call returns,
-	// as it's used in a debug function.
-	lua_pushnumber(L, 0);
+	Kernel *pKernel = Kernel::getInstance();
+	assert(pKernel);
+	ResourceManager *pResource = pKernel->getResourceManager();
+	assert(pResource);
+
+	// This is only used in a debug function, so report the memory
+	// used by the resource cache.
+	lua_pushnumber(L, pResource->getUsedMemory());
 	return 1;
 }
 
@@ -312,6 +317,9 @@ static int precacheResource(lua_State *L) {
 #ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
 #else
+	// Load the resource a bit later, while frames are being drawn, so that
+	// the script is not held up.
+	pResource->prefetchResource(luaL_checkstring(L, 1));
 	lua_pushbooleancpp(L, true);
 #endif
 
@@ -341,7 +349,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 
 	// This is used for debugging, so it doesn't really matter.
 	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -352,8 +360,8 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	// This call is ignored, the resource manager uses its own limits on
+	// the number and decoded size of simultaneously loaded resources.
 
 	return 0;
 }
@@ -29,12 +29,16 @@
  *
  */
 
+#include "common/system.h"
+
 #include "sword25/sword25.h"	// for kDebugResource
 #include "sword25/kernel/resmanager.h"
 #include "sword25/kernel/resource.h"
 #include "sword25/kernel/resservice.h"
 #include "sword25/package/packagemanager.h"
 
+#include "gui/debugger.h"
+
 namespace Sword25 {
 
 // Sets the amount of resources that are simultaneously loaded.
@@ -46,6 +50,10 @@ namespace Sword25 {
 // are loaded, the resource manager will start purging resources till it
 // hits the minimum limit above
 #define SWORD25_RESOURCECACHE_MAX 500
+// The number of bytes of decoded data the loaded resources may use. If they
+// use more, unlocked resources are purged, least recently used first, until
+// they fit again.
+#define SWORD25_RESOURCECACHE_BUDGET (64 * 1024 * 1024)
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -86,28 +94,34 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
  * Deletes resources as necessary until the specified memory limit is not being exceeded.
  */
 void ResourceManager::deleteResourcesIfNecessary() {
+	const bool tooMany = _resources.size() >= SWORD25_RESOURCECACHE_MAX;
+
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	if (!tooMany && _usedMemory <= SWORD25_RESOURCECACHE_BUDGET)
 		return;
 
 	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
 	// The list is processed backwards in order to first release those resources that have been
 	// not been accessed for the longest
 	Common::List<Resource *>::iterator iter = _resources.end();
-	do {
+	while (iter != _resources.begin() &&
+	       ((tooMany && _resources.size() >= SWORD25_RESOURCECACHE_MIN) || _usedMemory > SWORD25_RESOURCECACHE_BUDGET)) {
 		--iter;
 
 		// The resource may be released only if it isn't locked
-		if ((*iter)->getLockCount() == 0)
+		if ((*iter)->getLockCount() == 0) {
+			++_stats.evictions;
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+		}
+	}
 
 	// Are we still above the minimum? If yes, then start releasing locked resources
 	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
 	// in the resource lock code, and resources are not unlocked when changing rooms.
 	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
 	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
+	// The memory budget never gets here: it only ever releases unlocked resources.
+	if (!tooMany || _resources.size() <= SWORD25_RESOURCECACHE_MIN)
 		return;
 
 	iter = _resources.end();
@@ -124,6 +138,7 @@ void ResourceManager::deleteResourcesIfNecessary() {
 			while ((*iter)->getLockCount() > 0)
 				(*iter)->release();
 
+			++_stats.evictions;
 			iter = deleteResource(*iter);
 		}
 	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
@@ -172,8 +187,12 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	// Determine whether the resource is already loaded
 	// If the resource is found, it will be placed at the head of the resource list and returned
 	Resource *pResource = getResource(uniqueFileName);
-	if (!pResource)
+	if (pResource) {
+		++_stats.hits;
+	} else {
+		++_stats.misses;
 		pResource = loadResource(uniqueFileName);
+	}
 	if (pResource) {
 		moveToFront(pResource);
 		(pResource)->addReference();
@@ -220,6 +239,43 @@ bool ResourceManager::precacheResource(const Common::String &fileName, bool forc
 
 #endif
 
+/**
+ * Queues a resource to be loaded into the cache in the background
+ * @param FileName      The filename of the resource to be cached
+ */
+void ResourceManager::prefetchResource(const Common::String &fileName) {
+	_prefetchQueue.push(fileName);
+}
+
+/**
+ * Loads queued resources until the given time has passed
+ * @param MaxTime       The time in milliseconds which may be spent
+ */
+void ResourceManager::prefetchResources(uint32 maxTime) {
+	const uint32 startTime = g_system->getMillis();
+
+	while (!_prefetchQueue.empty()) {
+		Common::String uniqueFileName = getUniqueFileName(_prefetchQueue.pop());
+		if (uniqueFileName.empty() || getResource(uniqueFileName))
+			continue;
+
+		if (!loadResource(uniqueFileName)) {
+			// This isn't fatal - e.g. it can happen when loading saved games
+			debugC(kDebugResource, "Could not prefetch \"%s\",", uniqueFileName.c_str());
+			continue;
+		}
+
+		++_stats.prefetches;
+
+		if (g_system->getMillis() - startTime >= maxTime)
+			break;
+	}
+}
+
+uint ResourceManager::getMaxMemoryUsage() const {
+	return SWORD25_RESOURCECACHE_BUDGET;
+}
+
 /**
  * Moves a resource to the top of the resource list
  * @param pResource     The resource
@@ -260,6 +316,9 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			// Also store the resource in the hash table for quick lookup
 			_resourceHashMap[pResource->getFileName()] = pResource;
 
+			pResource->_memoryUsage = pResource->getMemoryUsage();
+			_usedMemory += pResource->_memoryUsage;
+
 			return pResource;
 		}
 	}
@@ -296,6 +355,8 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 	// Remove the resource from the hash table
 	_resourceHashMap.erase(pResource->_fileName);
 
+	_usedMemory -= pResource->_memoryUsage;
+
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
 
@@ -320,6 +381,14 @@ Resource *ResourceManager::getResource(const Common::String &uniquefileName) con
 	return NULL;
 }
 
+/**
+ * Writes the names, sizes and lock counts of all loaded resources to the debug console
+ */
+void ResourceManager::dumpResources(GUI::Debugger *console) const {
+	for (Common::List<Resource *>::const_iterator iter = _resources.begin(); iter != _resources.end(); ++iter)
+		console->DebugPrintf("%8u %3d %s\n", (*iter)->getMemoryUsage(), (*iter)->getLockCount(), (*iter)->getFileName().c_str());
+}
+
 /**
  * Writes the names of all currently locked resources to the log file
  */
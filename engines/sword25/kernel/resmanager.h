@@ -35,9 +35,14 @@
 #include "common/list.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/queue.h"
 
 #include "sword25/kernel/common.h"
 
+namespace GUI {
+class Debugger;
+}
+
 namespace Sword25 {
 
 //#define PRECACHE_RESOURCES
@@ -66,6 +71,59 @@ public:
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
 #endif
 
+	/**
+	 * Queues a resource to be loaded into the cache in the background
+	 * The queue is worked off a little at the end of every frame, see prefetchResources().
+	 * @param FileName      The filename of the resource to be cached
+	 */
+	void prefetchResource(const Common::String &fileName);
+
+	/**
+	 * Loads queued resources until the given time has passed
+	 * At least one resource is loaded if the queue is not empty.
+	 * @param MaxTime       The time in milliseconds which may be spent
+	 */
+	void prefetchResources(uint32 maxTime);
+
+	struct Stats {
+		Stats() : hits(0), misses(0), prefetches(0), evictions(0) {}
+
+		uint hits;              ///< Requests for resources which were already loaded
+		uint misses;            ///< Requests which had to load the resource
+		uint prefetches;        ///< Resources loaded from the prefetch queue
+		uint evictions;         ///< Resources released to stay within the cache limits
+	};
+
+	const Stats &getStats() const {
+		return _stats;
+	}
+
+	uint getResourceCount() const {
+		return _resources.size();
+	}
+
+	uint getPrefetchQueueSize() const {
+		return _prefetchQueue.size();
+	}
+
+	/**
+	 * Returns the number of bytes of decoded data held by all loaded resources
+	 * Resources are counted with the size they had when they were loaded.
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
+
+	/**
+	 * Returns the number of bytes of decoded data above which unlocked resources are released
+	 */
+	uint getMaxMemoryUsage() const;
+
+	/**
+	 * Writes the names, sizes and lock counts of all loaded resources to the debug console
+	 */
+	void dumpResources(GUI::Debugger *console) const;
+
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
 	 * BS_ResourceService, and thus helps all resource services in the ResourceManager list
@@ -94,7 +152,8 @@ private:
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_usedMemory(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -139,6 +198,9 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	Common::Queue<Common::String> _prefetchQueue;
+	Stats _stats;
+	uint _usedMemory;
 };
 
 } // End of namespace Sword25
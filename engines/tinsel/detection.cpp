@@ -86,6 +86,7 @@ class TinselMetaEngine : public AdvancedMetaEngine {
 public:
 	TinselMetaEngine() : AdvancedMetaEngine(Tinsel::gameDescriptions, sizeof(Tinsel::TinselGameDescription), tinselGames) {
 		_singleid = "tinsel";
+		_flags = kADFlagHasFallbackDetect;
 	}
 
 	virtual const char *getName() const {
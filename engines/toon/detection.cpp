@@ -128,6 +128,7 @@ class ToonMetaEngine : public AdvancedMetaEngine {
 public:
 	ToonMetaEngine() : AdvancedMetaEngine(Toon::gameDescriptions, sizeof(ADGameDescription), toonGames) {
 		_singleid = "toon";
+		_flags = kADFlagHasFallbackDetect;
 		_maxScanDepth = 3;
 		_directoryGlobs = directoryGlobs;
 	}
@@ -130,6 +130,7 @@ public:
 	ToucheMetaEngine() : AdvancedMetaEngine(Touche::gameDescriptions, sizeof(ADGameDescription), toucheGames) {
 		_md5Bytes = 4096;
 		_singleid = "touche";
+		_flags = kADFlagHasFallbackDetect;
 		_maxScanDepth = 2;
 		_directoryGlobs = directoryGlobs;
 	}
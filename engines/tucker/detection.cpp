@@ -117,6 +117,7 @@ public:
 	TuckerMetaEngine() : AdvancedMetaEngine(tuckerGameDescriptions, sizeof(ADGameDescription), tuckerGames) {
 		_md5Bytes = 512;
 		_singleid = "tucker";
+		_flags = kADFlagHasFallbackDetect;
 	}
 
 	virtual const char *getName() const {
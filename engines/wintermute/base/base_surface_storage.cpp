@@ -33,7 +33,9 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/platform_osystem.h"
+#include "engines/wintermute/wintermute.h"
 #include "common/str.h"
+#include "common/system.h"
 
 namespace Wintermute {
 
@@ -42,6 +44,7 @@ namespace Wintermute {
 //////////////////////////////////////////////////////////////////////
 BaseSurfaceStorage::BaseSurfaceStorage(BaseGame *inGame) : BaseClass(inGame) {
 	_lastCleanupTime = 0;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 
@@ -60,6 +63,8 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 		delete _surfaces[i];
 	}
 	_surfaces.clear();
+	_surfaceMap.clear();
+	_preloadQueue.clear();
 
 	return STATUS_OK;
 }
@@ -69,15 +74,29 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 bool BaseSurfaceStorage::initLoop() {
 	if (_gameRef->_smartCache && _gameRef->getLiveTimer()->getTime() - _lastCleanupTime >= _gameRef->_surfaceGCCycleTime) {
 		_lastCleanupTime = _gameRef->getLiveTimer()->getTime();
+
+		// Drop the least recently used images until the rest fit into the
+		// budget. Surfaces without a life time are never dropped.
+		uint32 usedMemory = getUsedMemory();
+		if (usedMemory <= kMemoryBudget) {
+			return STATUS_OK;
+		}
+
 		sortSurfaces();
-		for (uint32 i = 0; i < _surfaces.size(); i++) {
+		for (uint32 i = 0; i < _surfaces.size() && usedMemory > kMemoryBudget; i++) {
 			if (_surfaces[i]->_lifeTime <= 0) {
 				break;
 			}
 
-			if (_surfaces[i]->_lifeTime > 0 && _surfaces[i]->_valid && (int)(_gameRef->getLiveTimer()->getTime() - _surfaces[i]->_lastUsedTime) >= _surfaces[i]->_lifeTime) {
-				//_gameRef->QuickMessageForm("Invalidating: %s", _surfaces[i]->_filename);
-				_surfaces[i]->invalidate();
+			// Keep what is still on screen, or it would be decoded again right away
+			if (!_surfaces[i]->_valid || _lastCleanupTime - _surfaces[i]->_lastUsedTime < 1000) {
+				continue;
+			}
+
+			uint32 size = _surfaces[i]->getMemoryUsage();
+			if (DID_SUCCEED(_surfaces[i]->invalidate())) {
+				usedMemory -= size;
+				_stats.evictions++;
 			}
 		}
 	}
@@ -85,12 +104,52 @@ bool BaseSurfaceStorage::initLoop() {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::preloadSurfaces(uint32 maxTime) {
+	if (_preloadQueue.empty()) {
+		return;
+	}
+
+	uint32 start = g_system->getMillis();
+	uint32 usedMemory = getUsedMemory();
+	while (!_preloadQueue.empty() && usedMemory < kMemoryBudget && g_system->getMillis() - start < maxTime) {
+		BaseSurface *surface = _preloadQueue.front();
+		_preloadQueue.pop_front();
+
+		if (!surface->isLoaded() && DID_SUCCEED(surface->preload())) {
+			usedMemory += surface->getMemoryUsage();
+			_stats.preloads++;
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::addStall(BaseSurface *surface, uint32 time) {
+	_stats.stalls++;
+	_stats.stallTime += time;
+	debugC(kWintermuteDebugGraphics, "Decoded '%s' on first use, took %d ms", surface->getFileName(), time);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 BaseSurfaceStorage::getUsedMemory() {
+	uint32 usedMemory = 0;
+	for (uint32 i = 0; i < _surfaces.size(); i++) {
+		usedMemory += _surfaces[i]->getMemoryUsage();
+	}
+	return usedMemory;
+}
+
+
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 	for (uint32 i = 0; i < _surfaces.size(); i++) {
 		if (_surfaces[i] == surface) {
 			_surfaces[i]->_referenceCount--;
 			if (_surfaces[i]->_referenceCount <= 0) {
+				_surfaceMap.erase(_surfaces[i]->getFileNameStr());
+				_preloadQueue.remove(_surfaces[i]);
 				delete _surfaces[i];
 				_surfaces.remove_at(i);
 			}
@@ -103,11 +162,10 @@ bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 
 //////////////////////////////////////////////////////////////////////
 BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime, bool keepLoaded) {
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
-		if (scumm_stricmp(_surfaces[i]->getFileName(), filename.c_str()) == 0) {
-			_surfaces[i]->_referenceCount++;
-			return _surfaces[i];
-		}
+	SurfaceMap::iterator it = _surfaceMap.find(filename);
+	if (it != _surfaceMap.end()) {
+		it->_value->_referenceCount++;
+		return it->_value;
 	}
 
 	if (!BaseFileManager::getEngineInstance()->hasFile(filename)) {
@@ -134,6 +192,10 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 	} else {
 		surface->_referenceCount = 1;
 		_surfaces.push_back(surface);
+		_surfaceMap[filename] = surface;
+
+		// Start decoding the image before it is first drawn
+		_preloadQueue.push_back(surface);
 		return surface;
 	}
 }
@@ -31,6 +31,9 @@
 
 #include "engines/wintermute/base/base.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
 
 namespace Wintermute {
 class BaseSurface;
@@ -49,7 +52,39 @@ public:
 	BaseSurfaceStorage(BaseGame *inGame);
 	virtual ~BaseSurfaceStorage();
 
+	/**
+	 * Decode the images of newly added surfaces, until maxTime milliseconds
+	 * have passed or the decoded images exceed the memory budget.
+	 */
+	void preloadSurfaces(uint32 maxTime);
+
+	/** Report a surface which had to be decoded when it was first used. */
+	void addStall(BaseSurface *surface, uint32 time);
+
+	/** Bytes used by the decoded images of all surfaces. */
+	uint32 getUsedMemory();
+
+	/** Decode statistics, shown by the "surfaces" debugger command. */
+	struct Stats {
+		uint32 preloads;	///< Images decoded ahead of their first use
+		uint32 stalls;		///< Images decoded when they were first used
+		uint32 stallTime;	///< Milliseconds spent on those
+		uint32 evictions;	///< Images dropped to stay within the memory budget
+	};
+	const Stats &getStats() const { return _stats; }
+
+	enum {
+		kMemoryBudget = 64 * 1024 * 1024	///< Bytes of decoded images kept by the smart cache
+	};
+
 	Common::Array<BaseSurface *> _surfaces;
+
+private:
+	typedef Common::HashMap<Common::String, BaseSurface *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SurfaceMap;
+
+	SurfaceMap _surfaceMap;
+	Common::List<BaseSurface *> _preloadQueue;
+	Stats _stats;
 };
 
 } // end of namespace Wintermute
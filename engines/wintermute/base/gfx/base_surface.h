@@ -39,6 +39,19 @@ class BaseSurface: public BaseClass {
 public:
 	virtual bool invalidate();
 	virtual bool prepareToDraw();
+
+	/** Whether the image of the surface has been decoded. */
+	virtual bool isLoaded() {
+		return true;
+	}
+	/** Decode the image of the surface ahead of its first use. */
+	virtual bool preload() {
+		return STATUS_OK;
+	}
+	/** Bytes used by the decoded image. */
+	virtual uint32 getMemoryUsage() {
+		return 0;
+	}
 	uint32 _lastUsedTime;
 	bool _valid;
 	int32 _lifeTime;
@@ -28,6 +28,7 @@
 
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_surface_storage.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
 #include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/gfx/base_image.h"
@@ -65,7 +66,9 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	delete[] _alphaMask;
 	_alphaMask = nullptr;
 
-	_gameRef->addMem(-_width * _height * 4);
+	if (_valid) {
+		_gameRef->addMem(-_width * _height * 4);
+	}
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 }
@@ -181,6 +184,49 @@ bool BaseSurfaceOSystem::finishLoad() {
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceOSystem::loadOnDemand() {
+	// Only reached when the image was not preloaded in time
+	uint32 start = g_system->getMillis();
+	if (finishLoad() && _gameRef->_surfaceStorage) {
+		_gameRef->_surfaceStorage->addStall(this, g_system->getMillis() - start);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::preload() {
+	if (_loaded) {
+		return STATUS_OK;
+	}
+	return finishLoad() ? STATUS_OK : STATUS_FAILED;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::invalidate() {
+	// Only images loaded from a file can be decoded again
+	if (!_loaded || _filename.empty()) {
+		return STATUS_FAILED;
+	}
+
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
+	_surface->free();
+	_gameRef->addMem(-_width * _height * 4);
+	_loaded = false;
+	_valid = false;
+
+	return STATUS_OK;
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32 BaseSurfaceOSystem::getMemoryUsage() {
+	if (!_loaded || !_surface) {
+		return 0;
+	}
+	return _surface->pitch * _surface->h;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void BaseSurfaceOSystem::genAlphaMask(Graphics::Surface *surface) {
 	warning("BaseSurfaceOSystem::GenAlphaMask - Not ported yet");
@@ -354,8 +400,9 @@ bool BaseSurfaceOSystem::displayTransform(int x, int y, int hotX, int hotY, Rect
 bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, float zoomX, float zoomY, uint32 alpha, bool alphaDisable, TSpriteBlendMode blendMode, bool mirrorX, bool mirrorY, int offsetX, int offsetY) {
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 
+	_lastUsedTime = _gameRef->getLiveTimer()->getTime();
 	if (!_loaded) {
-		finishLoad();
+		loadOnDemand();
 	}
 
 	if (renderer->_forceAlphaColor != 0) {
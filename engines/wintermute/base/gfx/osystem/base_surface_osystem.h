@@ -47,6 +47,13 @@ public:
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
 
+	bool invalidate() override;
+	bool isLoaded() override {
+		return _loaded;
+	}
+	bool preload() override;
+	uint32 getMemoryUsage() override;
+
 	bool startPixelOp() override;
 	bool endPixelOp() override;
 
@@ -64,7 +71,7 @@ public:
 	    static long DLL_CALLCONV TellProc(fi_handle handle);*/
 	virtual int getWidth() override {
 		if (!_loaded) {
-			finishLoad();
+			loadOnDemand();
 		}
 		if (_surface) {
 			return _surface->w;
@@ -73,7 +80,7 @@ public:
 	}
 	virtual int getHeight() override {
 		if (!_loaded) {
-			finishLoad();
+			loadOnDemand();
 		}
 		if (_surface) {
 			return _surface->h;
@@ -85,6 +92,7 @@ private:
 	Graphics::Surface *_surface;
 	bool _loaded;
 	bool finishLoad();
+	void loadOnDemand();
 	bool drawSprite(int x, int y, Rect32 *rect, float zoomX, float zoomY, uint32 alpha, bool alphaDisable, TSpriteBlendMode blendMode, bool mirrorX, bool mirrorY, int offsetX = 0, int offsetY = 0);
 	void genAlphaMask(Graphics::Surface *surface);
 	uint32 getPixelAt(Graphics::Surface *surface, int x, int y);
@@ -47,6 +47,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varCache = nullptr;
 
 	_engine = engine;
 
@@ -174,6 +175,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	delete[] _varCache;
+	_varCache = new TVarCacheEntry[_numSymbols];
+	memset(_varCache, 0, _numSymbols * sizeof(TVarCacheEntry));
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -396,6 +401,9 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varCache;
+	_varCache = nullptr;
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -690,7 +698,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -701,15 +709,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -762,7 +769,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1162,6 +1169,39 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(uint32 symbol) {
+	ScValue *scope = (_scopeStack->_sP >= 0) ? _scopeStack->getTop() : nullptr;
+	ScValue *engineGlobals = _engine->_globals;
+
+	// Names are looked up in the scope, then in the script globals and then
+	// in the engine globals. As long as none of them gained or lost
+	// properties, the same name resolves to the same variable again.
+	TVarCacheEntry &entry = _varCache[symbol];
+	if (entry.var && entry.scope == scope &&
+	        (!scope || (scope->hasPlainProps() && scope->getPropsStamp() == entry.scopeStamp)) &&
+	        _globals->hasPlainProps() && _globals->getPropsStamp() == entry.globalsStamp &&
+	        engineGlobals->hasPlainProps() && engineGlobals->getPropsStamp() == entry.engineGlobalsStamp) {
+		return entry.var;
+	}
+
+	ScValue *ret = getVar(_symbols[symbol]);
+
+	// Lookups which may go through natives or references are not cached
+	if (ret && (!scope || scope->hasPlainProps()) && _globals->hasPlainProps() && engineGlobals->hasPlainProps()) {
+		entry.var = ret;
+		entry.scope = scope;
+		entry.scopeStamp = scope ? scope->getPropsStamp() : 0;
+		entry.globalsStamp = _globals->getPropsStamp();
+		entry.engineGlobalsStamp = engineGlobals->getPropsStamp();
+	} else {
+		entry.var = nullptr;
+	}
+
+	return ret;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
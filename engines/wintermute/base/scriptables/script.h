@@ -77,6 +77,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -150,6 +151,21 @@ public:
 private:
 	char **_symbols;
 	uint32 _numSymbols;
+
+	/**
+	 * The variable a symbol resolved to, together with the stamps of the
+	 * scope, script globals and engine globals it was resolved against.
+	 * The variable can be reused for as long as none of these gained or
+	 * lost properties.
+	 */
+	struct TVarCacheEntry {
+		ScValue *var;
+		ScValue *scope;
+		uint32 scopeStamp;
+		uint32 globalsStamp;
+		uint32 engineGlobalsStamp;
+	};
+	TVarCacheEntry *_varCache;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
 	TEventPos *_events;
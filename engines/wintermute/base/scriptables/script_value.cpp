@@ -40,7 +40,44 @@ namespace Wintermute {
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-IMPLEMENT_PERSISTENT(ScValue, false)
+IMPLEMENT_PERSISTENT_NO_ALLOC(ScValue, false)
+
+uint32 ScValue::_propsStampCounter = 0;
+
+// Scripts create and destroy values all the time, so they are allocated from
+// a pool instead of the heap. The pool is freed along with the last value.
+Common::MemoryPool *ScValue::_pool = nullptr;
+ScValue::Stats ScValue::_stats = { 0, 0, 0, 0 };
+
+void *ScValue::allocate() {
+	if (!_pool)
+		_pool = new Common::MemoryPool(sizeof(ScValue));
+
+	_stats.allocations++;
+	_stats.live++;
+	return _pool->allocChunk();
+}
+
+void *ScValue::persistBuild() {
+	// Loaded instances are registered by the persistence manager
+	return ::new ((void *)allocate()) ScValue(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);
+}
+
+void *ScValue::operator new(size_t size) {
+	assert(size == sizeof(ScValue));
+	void *ret = allocate();
+	SystemClassRegistry::getInstance()->registerInstance(_className, ret);
+	return ret;
+}
+
+void ScValue::operator delete(void *p) {
+	SystemClassRegistry::getInstance()->unregisterInstance(_className, p);
+	_pool->freeChunk(p);
+	if (--_stats.live == 0) {
+		delete _pool;
+		_pool = nullptr;
+	}
+}
 
 //////////////////////////////////////////////////////////////////////////
 ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
@@ -54,6 +91,7 @@ ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -69,6 +107,7 @@ ScValue::ScValue(BaseGame *inGame, bool val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -84,6 +123,7 @@ ScValue::ScValue(BaseGame *inGame, int32 val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -99,6 +139,7 @@ ScValue::ScValue(BaseGame *inGame, double val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -115,6 +156,7 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -122,9 +164,7 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 void ScValue::cleanup(bool ignoreNatives) {
 	deleteProps();
 
-	if (_valString) {
-		delete[] _valString;
-	}
+	freeStringVal();
 
 	if (!ignoreNatives) {
 		if (_valNative && !_persistent) {
@@ -201,6 +241,7 @@ bool ScValue::deleteProp(const char *name) {
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
+		touchProps();
 	}
 
 	return STATUS_OK;
@@ -228,6 +269,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		}
 		if (!newVal) {
 			newVal = new ScValue(_gameRef);
+			touchProps();
 		} else {
 			newVal->cleanup();
 		}
@@ -278,6 +320,7 @@ void ScValue::deleteProps() {
 		_valIter++;
 	}
 	_valObject.clear();
+	touchProps();
 }
 
 
@@ -449,20 +492,41 @@ void ScValue::setString(const Common::String &val) {
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::setStringVal(const char *val) {
-	if (_valString) {
-		delete[] _valString;
-		_valString = nullptr;
+	if (val == _valString) {
+		return;
 	}
 
 	if (val == nullptr) {
-		_valString = nullptr;
+		freeStringVal();
 		return;
 	}
 
-	_valString = new char [strlen(val) + 1];
-	if (_valString) {
-		strcpy(_valString, val);
+	// The new string may point into the old one, so copy before freeing
+	uint32 size = strlen(val) + 1;
+	char *str;
+	if (size <= kInlineStringSize) {
+		_stats.inlineStrings++;
+		if (_valString == _valStringInline) {
+			memmove(_valStringInline, val, size);
+			return;
+		}
+		str = _valStringInline;
+	} else {
+		str = new char [size];
+		_stats.heapStrings++;
 	}
+	memcpy(str, val, size);
+
+	freeStringVal();
+	_valString = str;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ScValue::freeStringVal() {
+	if (_valString != _valStringInline) {
+		delete[] _valString;
+	}
+	_valString = nullptr;
 }
 
 
@@ -813,6 +877,8 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			_valIter++;
 		}
 	} else {
+		touchProps();
+
 		ScValue *val = nullptr;
 		persistMgr->transfer("", &size);
 		for (int i = 0; i < size; i++) {
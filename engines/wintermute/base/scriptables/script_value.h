@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
+#include "common/memorypool.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -85,11 +86,46 @@ public:
 	ScValue *getProp(const char *name);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
+
+	/**
+	 * Returns a stamp which changes whenever properties are added to or
+	 * removed from this value. No two values share a stamp, so it can be
+	 * used to tell whether a property looked up earlier is still valid.
+	 */
+	uint32 getPropsStamp() const { return _propsStamp; }
+
+	/** Whether getProp() only looks at the properties stored in this value. */
+	bool hasPlainProps() const { return _type == VAL_OBJECT || _type == VAL_NULL; }
+
+	/** Allocation statistics, shown by the "values" debugger command. */
+	struct Stats {
+		uint32 allocations;	///< Values allocated since startup
+		uint32 live;		///< Values currently allocated
+		uint32 inlineStrings;	///< Strings stored inside the value since startup
+		uint32 heapStrings;	///< Strings allocated separately since startup
+	};
+	static const Stats &getStats() { return _stats; }
 private:
+	enum {
+		kInlineStringSize = 16
+	};
+
 	bool _valBool;
 	int32 _valInt;
 	double _valFloat;
 	char *_valString;
+	char _valStringInline[kInlineStringSize];	///< Storage for short strings
+
+	void freeStringVal();
+
+	static void *allocate();
+
+	static Common::MemoryPool *_pool;
+	static Stats _stats;
+
+	uint32 _propsStamp;
+	static uint32 _propsStampCounter;
+	void touchProps() { _propsStamp = ++_propsStampCounter; }
 public:
 	TValType _type;
 	ScValue(BaseGame *inGame);
@@ -25,12 +25,16 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_surface_storage.h"
+#include "engines/wintermute/base/scriptables/script_value.h"
 
 namespace Wintermute {
 
 Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	DCmd_Register("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	DCmd_Register("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	DCmd_Register("values", WRAP_METHOD(Console, Cmd_Values));
+	DCmd_Register("surfaces", WRAP_METHOD(Console, Cmd_Surfaces));
 }
 
 Console::~Console(void) {
@@ -81,4 +85,20 @@ bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_Values(int argc, const char **argv) {
+	const ScValue::Stats &stats = ScValue::getStats();
+	DebugPrintf("Script values: %d live, %d allocated\n", stats.live, stats.allocations);
+	DebugPrintf("Strings: %d inline, %d on the heap\n", stats.inlineStrings, stats.heapStrings);
+	return true;
+}
+
+bool Console::Cmd_Surfaces(int argc, const char **argv) {
+	BaseSurfaceStorage *storage = _engineRef->_game->_surfaceStorage;
+	const BaseSurfaceStorage::Stats &stats = storage->getStats();
+	DebugPrintf("Surfaces: %d, decoded images use %d of %d KB\n", storage->_surfaces.size(), storage->getUsedMemory() / 1024, BaseSurfaceStorage::kMemoryBudget / 1024);
+	DebugPrintf("Preloaded: %d, evicted: %d\n", stats.preloads, stats.evictions);
+	DebugPrintf("Decoded on first use: %d, taking %d ms\n", stats.stalls, stats.stallTime);
+	return true;
+}
+
 } // end of namespace Wintermute
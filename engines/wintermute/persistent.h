@@ -54,11 +54,13 @@ namespace Wintermute {
 	void operator delete(void* p);\
 
 
-#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+// Implements everything declared by DECLARE_PERSISTENT except persistBuild,
+// operator new and operator delete, for classes which allocate their instances
+// themselves. Their operator new and operator delete have to register and
+// unregister instances with the SystemClassRegistry; persistBuild must not, as
+// loaded instances are registered by the persistence manager.
+#define IMPLEMENT_PERSISTENT_NO_ALLOC(className, persistentClass)\
 	const char className::_className[] = #className;\
-	void* className::persistBuild() {\
-		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
-	}\
 	\
 	bool className::persistLoad(void *instance, BasePersistenceManager *persistMgr) {\
 		return ((className*)instance)->persist(persistMgr);\
@@ -69,6 +71,13 @@ namespace Wintermute {
 	}\
 	\
 	/*SystemClass Register##class_name(class_name::_className, class_name::PersistBuild, class_name::PersistLoad, persistent_class);*/\
+
+#define IMPLEMENT_PERSISTENT(className, persistentClass)\
+	IMPLEMENT_PERSISTENT_NO_ALLOC(className, persistentClass)\
+	\
+	void* className::persistBuild() {\
+		return ::new className(DYNAMIC_CONSTRUCTOR, DYNAMIC_CONSTRUCTOR);\
+	}\
 	\
 	void* className::operator new(size_t size) {\
 		void* ret = ::operator new(size);\
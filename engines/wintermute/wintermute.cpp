@@ -40,6 +40,7 @@
 
 #include "engines/wintermute/base/sound/base_sound_manager.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_surface_storage.h"
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/base/scriptables/script_engine.h"
 
@@ -74,6 +75,7 @@ WintermuteEngine::WintermuteEngine(OSystem *syst, const ADGameDescription *desc)
 	DebugMan.addDebugChannel(kWintermuteDebugFileAccess, "file-access", "Non-critical problems like missing files");
 	DebugMan.addDebugChannel(kWintermuteDebugAudio, "audio", "audio-playback-related issues");
 	DebugMan.addDebugChannel(kWintermuteDebugGeneral, "general", "various issues not covered by any of the above");
+	DebugMan.addDebugChannel(kWintermuteDebugGraphics, "graphics", "Images decoded when first drawn");
 
 	_game = nullptr;
 	_debugger = nullptr;
@@ -239,7 +241,12 @@ int WintermuteEngine::messageLoop() {
 			time = _system->getMillis();
 			diff = time - prevTime;
 			if (frameTime > diff) { // Avoid overflows
-				_system->delayMillis(frameTime - diff);
+				// Decode the images of new surfaces while waiting for the next frame
+				_game->_surfaceStorage->preloadSurfaces(frameTime - diff);
+				uint32 elapsed = _system->getMillis() - time;
+				if (frameTime - diff > elapsed) {
+					_system->delayMillis(frameTime - diff - elapsed);
+				}
 			}
 
 			// ***** flip
@@ -33,7 +33,8 @@
 
 #include "common/singleton.h"
 #include "common/stream.h"
-#include "common/hashmap.h"
+#include "common/textconsole.h"
+#include "common/util.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -128,19 +129,38 @@ private:
 		int advance;
 	};
 
-	bool cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr);
-	typedef Common::HashMap<byte, Glyph> GlyphCache;
-	GlyphCache _glyphs;
+	enum GlyphState {
+		kGlyphNotLoaded,
+		kGlyphLoaded,
+		kGlyphInvalid
+	};
+
+	/**
+	 * Returns the glyph of the given character. Glyphs are only rendered
+	 * by FreeType the first time they are used.
+	 */
+	const Glyph &getGlyph(byte chr) const;
+	bool cacheGlyph(Glyph &glyph, FT_UInt slot) const;
+
+	mutable Glyph _glyphs[256];
+	mutable byte _glyphStates[256];
 
 	FT_UInt _glyphSlots[256];
 
+	/**
+	 * Kerning offsets between all pairs of characters. Each row holds the
+	 * offsets for one left character and is filled on first use.
+	 */
+	mutable int8 *_kerningRows[256];
+
 	bool _monochrome;
 	bool _hasKerning;
 };
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _glyphSlots(), _monochrome(false), _hasKerning(false) {
+      _descent(0), _glyphs(), _glyphStates(), _glyphSlots(), _kerningRows(), _monochrome(false),
+      _hasKerning(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -150,8 +170,11 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (uint i = 0; i < 256; ++i) {
+			_glyphs[i].image.free();
+			delete[] _kerningRows[i];
+			_kerningRows[i] = 0;
+		}
 
 		_initialized = false;
 	}
@@ -211,30 +234,75 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, uint dpi, bool
 	_width = ftCeil26_6(FT_MulFix(_face->max_advance_width, _face->size->metrics.x_scale));
 	_height = _ascent - _descent + 1;
 
+	// Only look up the glyph slots here. The glyphs themselves are rendered
+	// when they are used for the first time.
 	if (!mapping) {
-		// Load all ISO-8859-1 characters.
-		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], i))
-				_glyphSlots[i] = 0;
-		}
+		// Use all ISO-8859-1 characters.
+		for (uint i = 0; i < 256; ++i)
+			_glyphSlots[i] = FT_Get_Char_Index(_face, i);
 	} else {
 		for (uint i = 0; i < 256; ++i) {
 			const uint32 unicode = mapping[i] & 0x7FFFFFFF;
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
+			_glyphSlots[i] = FT_Get_Char_Index(_face, unicode);
+
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], _glyphSlots[i], unicode)) {
-				_glyphSlots[i] = 0;
-				if (isRequired)
+			if (isRequired) {
+				if (!_glyphSlots[i] || !cacheGlyph(_glyphs[i], _glyphSlots[i])) {
+					for (uint j = 0; j <= i; ++j)
+						_glyphs[j].image.free();
+
 					return false;
+				}
+
+				_glyphStates[i] = kGlyphLoaded;
 			}
 		}
 	}
 
-	_initialized = (_glyphs.size() != 0);
+	// Make sure at least one glyph can actually be rendered before reporting
+	// success. Probe '?' first, since it is the usual replacement character.
+	bool hasGlyph = false;
+	for (uint i = 0; i < 256 && !hasGlyph; ++i) {
+		const byte chr = (byte)('?' + i);
+		if (_glyphSlots[chr]) {
+			getGlyph(chr);
+			hasGlyph = (_glyphStates[chr] == kGlyphLoaded);
+		}
+	}
+
+	if (!hasGlyph) {
+		for (uint i = 0; i < 256; ++i)
+			_glyphs[i].image.free();
+
+		delete[] _ttfFile;
+		_ttfFile = 0;
+
+		g_ttf.closeFont(_face);
+
+		return false;
+	}
+
+	_initialized = true;
 	return _initialized;
 }
 
+const TTFFont::Glyph &TTFFont::getGlyph(byte chr) const {
+	if (_glyphStates[chr] == kGlyphNotLoaded) {
+		if (_glyphSlots[chr] && cacheGlyph(_glyphs[chr], _glyphSlots[chr])) {
+			_glyphStates[chr] = kGlyphLoaded;
+		} else {
+			// Make sure invalid glyphs are neither drawn nor take up space
+			_glyphs[chr].image.free();
+			_glyphs[chr].xOffset = _glyphs[chr].yOffset = _glyphs[chr].advance = 0;
+			_glyphStates[chr] = kGlyphInvalid;
+		}
+	}
+
+	return _glyphs[chr];
+}
+
 int TTFFont::getFontHeight() const {
 	return _height;
 }
@@ -244,11 +312,7 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(byte chr) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return 0;
-	else
-		return glyphEntry->_value.advance;
+	return getGlyph(chr).advance;
 }
 
 int TTFFont::getKerningOffset(byte left, byte right) const {
@@ -261,9 +325,23 @@ int TTFFont::getKerningOffset(byte left, byte right) const {
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
-	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	if (!_kerningRows[left]) {
+		int8 *row = new int8[256];
+
+		for (uint i = 0; i < 256; ++i) {
+			FT_Vector kerningVector;
+			kerningVector.x = 0;
+
+			if (_glyphSlots[i])
+				FT_Get_Kerning(_face, leftGlyph, _glyphSlots[i], FT_KERNING_DEFAULT, &kerningVector);
+
+			row[i] = (int8)CLIP<FT_Pos>(kerningVector.x / 64, -128, 127);
+		}
+
+		_kerningRows[left] = row;
+	}
+
+	return _kerningRows[left][right];
 }
 
 namespace {
@@ -305,12 +383,10 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph &glyph = getGlyph(chr);
+	if (!glyph.image.pixels)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
-
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -376,11 +452,7 @@ void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const
 	}
 }
 
-bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr) {
-	slot = FT_Get_Char_Index(_face, chr);
-	if (!slot)
-		return false;
-
+bool TTFFont::cacheGlyph(Glyph &glyph, FT_UInt slot) const {
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticable in FreeSansBold.ttf, where otherwise the
 	// 't' glyph looks like it is cut off on the right side.
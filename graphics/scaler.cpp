@@ -28,14 +28,11 @@
 
 int gBitFormat = 565;
 
-extern "C" {
-	uint32 *RGBtoYUV = 0;
-}
-#ifdef USE_HQ_SCALERS
-// RGB-to-YUV lookup table
+#if defined(USE_HQ_SCALERS) && defined(USE_NASM)
+// RGB-to-YUV lookup table, only used by the assembly versions of the hq
+// scalers. The C versions compute the YUV values as they go.
 extern "C" {
 
-#ifdef USE_NASM
 // NOTE: if your compiler uses different mangled names, add another
 //       condition here
 
@@ -58,11 +55,9 @@ uint32 hqx_greenMask = 0;
 uint32 hqx_redBlueMask = 0;
 uint32 hqx_green_redBlue_Mask = 0;
 
-#endif
-
 /**
  * 16bit RGB to YUV conversion table. This table is setup by InitLUT().
- * Used by the hq scaler family.
+ * Used by the assembly versions of the hq scaler family.
  *
  * FIXME/TODO: The RGBtoYUV table sucks up 256 KB. This is bad.
  * In addition we never free it...
@@ -105,7 +100,6 @@ void InitLUT(Graphics::PixelFormat format) {
 		RGBtoYUV[color] = (Y << 16) | (u << 8) | v;
 	}
 
-#ifdef USE_NASM
 	hqx_lowbits  = (1 << format.rShift) | (1 << format.gShift) | (1 << format.bShift),
 	hqx_low2bits = (3 << format.rShift) | (3 << format.gShift) | (3 << format.bShift),
 	hqx_low3bits = (7 << format.rShift) | (7 << format.gShift) | (7 << format.bShift),
@@ -118,7 +112,6 @@ void InitLUT(Graphics::PixelFormat format) {
 	hqx_redBlueMask = format.RGBToColor(255,0,255);
 
 	hqx_green_redBlue_Mask = (hqx_greenMask << 16) | hqx_redBlueMask;
-#endif
 }
 #endif
 
@@ -143,7 +136,7 @@ void InitScalers(uint32 BitFormat) {
 		format = g_system->getOverlayFormat();
 	}
 
-#ifdef USE_HQ_SCALERS
+#if defined(USE_HQ_SCALERS) && defined(USE_NASM)
 	InitLUT(format);
 #endif
 
@@ -156,7 +149,7 @@ void InitScalers(uint32 BitFormat) {
 }
 
 void DestroyScalers() {
-#ifdef USE_HQ_SCALERS
+#if defined(USE_HQ_SCALERS) && defined(USE_NASM)
 	free(RGBtoYUV);
 	RGBtoYUV = 0;
 #endif
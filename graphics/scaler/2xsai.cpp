@@ -86,6 +86,20 @@ void Super2xSaITemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uin
 			colorA2 = *(bP + 2 * nextlineSrc + 1);
 			colorA3 = *(bP + 2 * nextlineSrc + 2);
 
+			// Flat areas, where all the pixels looked at are the same, are
+			// common in game graphics and just come out as that color.
+			if (color5 == color6 && color5 == color2 && color5 == color3 &&
+			    color5 == color4 && color5 == color1 && color5 == colorS2 && color5 == colorS1 &&
+			    color5 == colorB1 && color5 == colorB2 && color5 == colorA1 && color5 == colorA2 &&
+			    color5 == colorB0 && color5 == colorB3 && color5 == colorA0 && color5 == colorA3) {
+				*(dP + 0) = *(dP + 1) = (uint16) color5;
+				*(dP + dstPitch/2 + 0) = *(dP + dstPitch/2 + 1) = (uint16) color5;
+
+				bP += 1;
+				dP += 2;
+				continue;
+			}
+
 //--------------------------------------
 			if (color2 == color6 && color5 != color3) {
 				product2b = product1b = color2;
@@ -189,6 +203,18 @@ void SuperEagleTemplate(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uin
 			colorA1 = *(bP + 2 * nextlineSrc);
 			colorA2 = *(bP + 2 * nextlineSrc + 1);
 
+			// Flat areas come out as their color, see Super2xSaITemplate()
+			if (color5 == color6 && color5 == color2 && color5 == color3 &&
+			    color5 == color4 && color5 == color1 && color5 == colorS2 && color5 == colorS1 &&
+			    color5 == colorB1 && color5 == colorB2 && color5 == colorA1 && color5 == colorA2) {
+				*(dP + 0) = *(dP + 1) = (uint16) color5;
+				*(dP + dstPitch/2 + 0) = *(dP + dstPitch/2 + 1) = (uint16) color5;
+
+				bP += 1;
+				dP += 2;
+				continue;
+			}
+
 			// --------------------------------------
 			if (color5 != color3) {
 				if (color2 == color6) {
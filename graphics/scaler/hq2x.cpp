@@ -93,8 +93,7 @@ void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 #define PIXEL11_90	*(q+1+nextlineDst) = interpolate16_2_3_3<ColorMask >(w5, w6, w8);
 #define PIXEL11_100	*(q+1+nextlineDst) = interpolate16_14_1_1<ColorMask >(w5, w6, w8);
 
-extern "C" uint32   *RGBtoYUV;
-#define YUV(x)	RGBtoYUV[w ## x]
+#define YUV(x)	yuv ## x
 
 /*
  * The HQ2x high quality 2x graphics filter.
@@ -105,6 +104,10 @@ template<typename ColorMask>
 static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	register int w1, w2, w3, w4, w5, w6, w7, w8, w9;
 
+	// YUV values of w1 to w9, moved along with them as the window
+	// advances, so that each pixel is only converted once per row.
+	int yuv1, yuv2, yuv3, yuv4, yuv5, yuv6, yuv7, yuv8, yuv9;
+
 	const uint32 nextlineSrc = srcPitch / sizeof(uint16);
 	const uint16 *p = (const uint16 *)srcPtr;
 
@@ -131,6 +134,14 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		yuv1 = convertRGBToYUV<ColorMask>(w1);
+		yuv4 = convertRGBToYUV<ColorMask>(w4);
+		yuv7 = convertRGBToYUV<ColorMask>(w7);
+
+		yuv2 = convertRGBToYUV<ColorMask>(w2);
+		yuv5 = convertRGBToYUV<ColorMask>(w5);
+		yuv8 = convertRGBToYUV<ColorMask>(w8);
+
 		int tmpWidth = width;
 		while (tmpWidth--) {
 			p++;
@@ -139,16 +150,19 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
+			yuv3 = convertRGBToYUV<ColorMask>(w3);
+			yuv6 = convertRGBToYUV<ColorMask>(w6);
+			yuv9 = convertRGBToYUV<ColorMask>(w9);
+
 			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			if (w5 != w1 && diffYUV(YUV(5), YUV(1))) pattern |= 0x0001;
+			if (w5 != w2 && diffYUV(YUV(5), YUV(2))) pattern |= 0x0002;
+			if (w5 != w3 && diffYUV(YUV(5), YUV(3))) pattern |= 0x0004;
+			if (w5 != w4 && diffYUV(YUV(5), YUV(4))) pattern |= 0x0008;
+			if (w5 != w6 && diffYUV(YUV(5), YUV(6))) pattern |= 0x0010;
+			if (w5 != w7 && diffYUV(YUV(5), YUV(7))) pattern |= 0x0020;
+			if (w5 != w8 && diffYUV(YUV(5), YUV(8))) pattern |= 0x0040;
+			if (w5 != w9 && diffYUV(YUV(5), YUV(9))) pattern |= 0x0080;
 
 			switch (pattern) {
 			case 0:
@@ -1950,6 +1964,14 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w5 = w6;
 			w8 = w9;
 
+			yuv1 = yuv2;
+			yuv4 = yuv5;
+			yuv7 = yuv8;
+
+			yuv2 = yuv3;
+			yuv5 = yuv6;
+			yuv8 = yuv9;
+
 			q += 2;
 		}
 		p += nextlineSrc - width;
@@ -179,6 +179,24 @@ static inline unsigned interpolate16_1_1_1_1(unsigned p1, unsigned p2, unsigned
 	return ((p1+p2+p3+p4) - lowbits) >> 2;
 }
 
+/**
+ * Convert a 16 bit pixel to the YUV values (encoded 8-8-8) compared by the
+ * hq scaler family. This gives the same values as the RGBtoYUV table used
+ * by the assembly versions, but only takes a few register operations, so
+ * the C versions do not need to go through a 256 KB table in memory.
+ */
+template<typename ColorMask>
+static inline int convertRGBToYUV(unsigned color) {
+	const int r = (((color & ColorMask::kRedMask) >> ColorMask::kRedShift) << (8 - ColorMask::kRedBits)) & 0xFF;
+	const int g = (((color & ColorMask::kGreenMask) >> ColorMask::kGreenShift) << (8 - ColorMask::kGreenBits)) & 0xFF;
+	const int b = (((color & ColorMask::kBlueMask) >> ColorMask::kBlueShift) << (8 - ColorMask::kBlueBits)) & 0xFF;
+
+	const int Y = (r + g + b) >> 2;
+	const int u = 128 + ((r - b) >> 2);
+	const int v = 128 + ((-r + 2 * g - b) >> 3);
+	return (Y << 16) | (u << 8) | v;
+}
+
 /**
  * Compare two YUV values (encoded 8-8-8) and check if they differ by more than
  * a certain hard coded threshold. Used by the hq scaler family.
@@ -191,31 +209,12 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 	static const int trU   = 0x00000700;
 	static const int trV   = 0x00000006;
 
-	int diff;
-	int mask;
-
-	diff = ((yuv1 & Umask) - (yuv2 & Umask));
-	mask = diff >> 31; // -1 if value < 0, 0 otherwise
-	diff = (diff ^ mask) - mask; //-1: ~value + 1; 0: value
-	if (diff > trU) return true;
-
-	diff = ((yuv1 & Vmask) - (yuv2 & Vmask));
-	mask = diff >> 31; // -1 if value < 0, 0 otherwise
-	diff = (diff ^ mask) - mask; //-1: ~value + 1; 0: value
-	if (diff > trV) return true;
-
-	diff = ((yuv1 & Ymask) - (yuv2 & Ymask));
-	mask = diff >> 31; // -1 if value < 0, 0 otherwise
-	diff = (diff ^ mask) - mask; //-1: ~value + 1; 0: value
-	if (diff > trY) return true;
-
-	return false;
-/*
-	return
-	  ( ( ABS((yuv1 & Ymask) - (yuv2 & Ymask)) > trY ) ||
-	    ( ABS((yuv1 & Umask) - (yuv2 & Umask)) > trU ) ||
-	    ( ABS((yuv1 & Vmask) - (yuv2 & Vmask)) > trV ) );
-*/
+	// |a - b| > t is the same as (unsigned)(a - b + t) > 2 * t. Combining
+	// the three comparisons with | instead of || keeps this free of branches,
+	// which mispredict a lot on real images.
+	return ((uint32)((yuv1 & Ymask) - (yuv2 & Ymask) + trY) > (uint32)(2 * trY)) |
+	       ((uint32)((yuv1 & Umask) - (yuv2 & Umask) + trU) > (uint32)(2 * trU)) |
+	       ((uint32)((yuv1 & Vmask) - (yuv2 & Vmask) + trV) > (uint32)(2 * trV));
 }
 
 #endif
@@ -58,21 +58,33 @@ static inline void scale2x_8_def_single(scale2x_uint8* __restrict__ dst, const s
 	}
 }
 
-static inline void scale2x_16_def_single(scale2x_uint16* __restrict__ dst, const scale2x_uint16* __restrict__ src0, const scale2x_uint16* __restrict__ src1, const scale2x_uint16* __restrict__ src2, unsigned count) {
+/*
+ * Both destination rows of a source row are computed in one pass, so that
+ * the neighbours are loaded and the common condition is tested only once
+ * per source pixel instead of once per destination row.
+ */
+static inline void scale2x_16_def_whole(scale2x_uint16* __restrict__ dst0, scale2x_uint16* __restrict__ dst1, const scale2x_uint16* __restrict__ src0, const scale2x_uint16* __restrict__ src1, const scale2x_uint16* __restrict__ src2, unsigned count) {
 	/* central pixels */
 	while (count) {
+		const scale2x_uint16 E = src1[0];
+
 		if (src0[0] != src2[0] && src1[-1] != src1[1]) {
-			dst[0] = src1[-1] == src0[0] ? src0[0] : src1[0];
-			dst[1] = src1[1] == src0[0] ? src0[0] : src1[0];
+			const scale2x_uint16 B = src0[0], D = src1[-1], F = src1[1], H = src2[0];
+
+			dst0[0] = D == B ? B : E;
+			dst0[1] = F == B ? B : E;
+			dst1[0] = D == H ? H : E;
+			dst1[1] = F == H ? H : E;
 		} else {
-			dst[0] = src1[0];
-			dst[1] = src1[0];
+			dst0[0] = dst0[1] = E;
+			dst1[0] = dst1[1] = E;
 		}
 
 		++src0;
 		++src1;
 		++src2;
-		dst += 2;
+		dst0 += 2;
+		dst1 += 2;
 		--count;
 	}
 }
@@ -126,8 +138,7 @@ void scale2x_8_def(scale2x_uint8* dst0, scale2x_uint8* dst1, const scale2x_uint8
  * @param dst1 Second destination row, double length in pixels.
  */
 void scale2x_16_def(scale2x_uint16* dst0, scale2x_uint16* dst1, const scale2x_uint16* src0, const scale2x_uint16* src1, const scale2x_uint16* src2, unsigned count) {
-	scale2x_16_def_single(dst0, src0, src1, src2, count);
-	scale2x_16_def_single(dst1, src2, src1, src0, count);
+	scale2x_16_def_whole(dst0, dst1, src0, src1, src2, count);
 }
 
 /**
@@ -81,44 +81,42 @@ static inline void scale3x_8_def_center(scale3x_uint8* __restrict__ dst, const s
 	}
 }
 
-static inline void scale3x_16_def_border(scale3x_uint16* __restrict__ dst, const scale3x_uint16* __restrict__ src0, const scale3x_uint16* __restrict__ src1, const scale3x_uint16* __restrict__ src2, unsigned count) {
+/*
+ * All three destination rows of a source row are computed in one pass, so
+ * that the neighbours are loaded and the common condition is tested only
+ * once per source pixel instead of once per destination row.
+ */
+static inline void scale3x_16_def_whole(scale3x_uint16* __restrict__ dst0, scale3x_uint16* __restrict__ dst1, scale3x_uint16* __restrict__ dst2, const scale3x_uint16* __restrict__ src0, const scale3x_uint16* __restrict__ src1, const scale3x_uint16* __restrict__ src2, unsigned count) {
 	/* central pixels */
 	while (count) {
-		if (src0[0] != src2[0] && src1[-1] != src1[1]) {
-			dst[0] = src1[-1] == src0[0] ? src1[-1] : src1[0];
-			dst[1] = (src1[-1] == src0[0] && src1[0] != src0[1]) || (src1[1] == src0[0] && src1[0] != src0[-1]) ? src0[0] : src1[0];
-			dst[2] = src1[1] == src0[0] ? src1[1] : src1[0];
-		} else {
-			dst[0] = src1[0];
-			dst[1] = src1[0];
-			dst[2] = src1[0];
-		}
-
-		++src0;
-		++src1;
-		++src2;
-		dst += 3;
-		--count;
-	}
-}
+		const scale3x_uint16 E = src1[0];
 
-static inline void scale3x_16_def_center(scale3x_uint16* __restrict__ dst, const scale3x_uint16* __restrict__ src0, const scale3x_uint16* __restrict__ src1, const scale3x_uint16* __restrict__ src2, unsigned count) {
-	/* central pixels */
-	while (count) {
 		if (src0[0] != src2[0] && src1[-1] != src1[1]) {
-			dst[0] = (src1[-1] == src0[0] && src1[0] != src2[-1]) || (src1[-1] == src2[0] && src1[0] != src0[-1]) ? src1[-1] : src1[0];
-			dst[1] = src1[0];
-			dst[2] = (src1[1] == src0[0] && src1[0] != src2[1]) || (src1[1] == src2[0] && src1[0] != src0[1]) ? src1[1] : src1[0];
+			const scale3x_uint16 A = src0[-1], B = src0[0], C = src0[1];
+			const scale3x_uint16 D = src1[-1], F = src1[1];
+			const scale3x_uint16 G = src2[-1], H = src2[0], I = src2[1];
+
+			dst0[0] = D == B ? D : E;
+			dst0[1] = (D == B && E != C) || (F == B && E != A) ? B : E;
+			dst0[2] = F == B ? F : E;
+			dst1[0] = (D == B && E != G) || (D == H && E != A) ? D : E;
+			dst1[1] = E;
+			dst1[2] = (F == B && E != I) || (F == H && E != C) ? F : E;
+			dst2[0] = D == H ? D : E;
+			dst2[1] = (D == H && E != I) || (F == H && E != G) ? H : E;
+			dst2[2] = F == H ? F : E;
 		} else {
-			dst[0] = src1[0];
-			dst[1] = src1[0];
-			dst[2] = src1[0];
+			dst0[0] = dst0[1] = dst0[2] = E;
+			dst1[0] = dst1[1] = dst1[2] = E;
+			dst2[0] = dst2[1] = dst2[2] = E;
 		}
 
 		++src0;
 		++src1;
 		++src2;
-		dst += 3;
+		dst0 += 3;
+		dst1 += 3;
+		dst2 += 3;
 		--count;
 	}
 }
@@ -198,9 +196,7 @@ void scale3x_8_def(scale3x_uint8* dst0, scale3x_uint8* dst1, scale3x_uint8* dst2
  * @param dst2 Third destination row, triple length in pixels.
  */
 void scale3x_16_def(scale3x_uint16* dst0, scale3x_uint16* dst1, scale3x_uint16* dst2, const scale3x_uint16* src0, const scale3x_uint16* src1, const scale3x_uint16* src2, unsigned count) {
-	scale3x_16_def_border(dst0, src0, src1, src2, count);
-	scale3x_16_def_center(dst1, src0, src1, src2, count);
-	scale3x_16_def_border(dst2, src2, src1, src0, count);
+	scale3x_16_def_whole(dst0, dst1, dst2, src0, src1, src2, count);
 }
 
 /**
@@ -158,7 +158,8 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 }
 
 YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
+	for (int i = 0; i < kLookupCount; i++)
+		_lookups[i] = 0;
 
 	int16 *Cr_r_tab = &_colorTab[0 * 256];
 	int16 *Cr_g_tab = &_colorTab[1 * 256];
@@ -180,16 +181,32 @@ YUVToRGBManager::YUVToRGBManager() {
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (int i = 0; i < kLookupCount; i++)
+		delete _lookups[i];
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
-		return _lookup;
+	// Building a table takes 2304 color conversions, so keep the ones of
+	// several formats around instead of rebuilding them whenever videos
+	// (or the frames of one video) alternate between formats or scales.
+	int i;
+	for (i = 0; i < kLookupCount - 1; i++) {
+		if (!_lookups[i] || (_lookups[i]->getFormat() == format && _lookups[i]->getScale() == scale))
+			break;
+	}
+
+	YUVToRGBLookup *lookup = _lookups[i];
+	if (!lookup || lookup->getFormat() != format || lookup->getScale() != scale) {
+		delete lookup;
+		lookup = new YUVToRGBLookup(format, scale);
+	}
 
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale);
-	return _lookup;
+	// Move it to the front
+	for (; i > 0; i--)
+		_lookups[i] = _lookups[i - 1];
+	_lookups[0] = lookup;
+
+	return lookup;
 }
 
 #define PUT_PIXEL(s, d) \
@@ -298,19 +315,15 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 		convertYUV420ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
-#define READ_QUAD(ptr, prefix) \
-	byte prefix##A = ptr[index]; \
-	byte prefix##B = ptr[index + 1]; \
-	byte prefix##C = ptr[index + uvPitch]; \
-	byte prefix##D = ptr[index + uvPitch + 1]
-
-#define DO_INTERPOLATION(out) \
-	out = (out##A * (4 - xDiff) * (4 - yDiff) + out##B * xDiff * (4 - yDiff) + \
-			out##C * yDiff * (4 - xDiff) + out##D * xDiff * yDiff) >> 4
+#define READ_COLUMNS(ptr, prefix) \
+	int prefix##Left  = ptr[index]     * (4 - yDiff) + ptr[index + uvPitch]     * yDiff; \
+	int prefix##Right = ptr[index + 1] * (4 - yDiff) + ptr[index + uvPitch + 1] * yDiff; \
+	int prefix##Step  = prefix##Right - prefix##Left; \
+	int prefix##Acc   = prefix##Left * 4
 
 #define DO_YUV410_PIXEL() \
-	DO_INTERPOLATION(u); \
-	DO_INTERPOLATION(v); \
+	u = uAcc >> 4; \
+	v = vAcc >> 4; \
 	\
 	cr_r  = Cr_r_tab[v]; \
 	crb_g = Cr_g_tab[v] + Cb_g_tab[u]; \
@@ -320,7 +333,8 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	dstPtr += sizeof(PixelInt); \
 	\
 	ySrc++; \
-	xDiff++
+	uAcc += uStep; \
+	vAcc += vStep
 
 template<typename PixelInt>
 void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
@@ -334,22 +348,24 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	int quarterWidth = yWidth >> 2;
 
 	for (int y = 0; y < yHeight; y++) {
-		for (int x = 0; x < quarterWidth; x++) {
+		int yDiff = y & 3;
+		int index = (y >> 2) * uvPitch;
+
+		for (int x = 0; x < quarterWidth; x++, index++) {
 			// Perform bilinear interpolation on the the chroma values
 			// Based on the algorithm found here: http://tech-algorithm.com/articles/bilinear-image-scaling/
-			// Feel free to optimize further
-			int targetY = y >> 2;
-			int xDiff = 0;
-			int yDiff = y & 3;
-			int index = targetY * uvPitch + x;
+			// The vertical part is done once per four pixels. The horizontal
+			// part is then a simple step, which gives the same result as
+			// (A * (4 - xDiff) * (4 - yDiff) + B * xDiff * (4 - yDiff) +
+			//  C * yDiff * (4 - xDiff) + D * xDiff * yDiff) >> 4
 
 			// Declare some variables for the following macros
 			byte u, v;
 			int16 cr_r, crb_g, cb_b;
 			register const uint32 *L;
 
-			READ_QUAD(uSrc, u);
-			READ_QUAD(vSrc, v);
+			READ_COLUMNS(uSrc, u);
+			READ_COLUMNS(vSrc, v);
 
 			DO_YUV410_PIXEL();
 			DO_YUV410_PIXEL();
@@ -362,8 +378,7 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
-#undef READ_QUAD
-#undef DO_INTERPOLATION
+#undef READ_COLUMNS
 #undef DO_YUV410_PIXEL
 
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
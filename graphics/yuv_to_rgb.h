@@ -39,6 +39,13 @@ namespace Graphics {
 
 class YUVToRGBLookup;
 
+/**
+ * Converts YUV images into RGB surfaces.
+ *
+ * The destination can be any 16 or 32bpp surface. When the video is shown
+ * unscaled, the surface returned by OSystem::lockScreen() can be passed in
+ * directly to avoid converting into an intermediate surface first.
+ */
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
 	/** The scale of the luminance values */
@@ -105,7 +112,11 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
-	YUVToRGBLookup *_lookup;
+	enum {
+		kLookupCount = 4 ///< Number of lookup tables kept, for videos in different formats or scales
+	};
+
+	YUVToRGBLookup *_lookups[kLookupCount]; ///< Most recently used first
 	int16 _colorTab[4 * 256]; // 2048 bytes
 };
 
@@ -0,0 +1,435 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "gui/ThemeCache.h"
+#include "gui/ThemeEngine.h"
+#include "gui/ThemeEval.h"
+
+#include "base/version.h"
+
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include "graphics/VectorRenderer.h"
+
+namespace Common {
+DECLARE_SINGLETON(GUI::ThemeCache);
+}
+
+namespace GUI {
+
+static const char *const kThemeCacheFileName = "themes.cache";
+static const uint32 kThemeCacheTag = MKTAG('S', 'T', 'X', 'C');
+
+/** Drawing functions of draw steps, in the order they are stored */
+static const Graphics::DrawingFunctionCallback kDrawingCalls[] = {
+	&Graphics::VectorRenderer::drawCallback_CIRCLE,
+	&Graphics::VectorRenderer::drawCallback_SQUARE,
+	&Graphics::VectorRenderer::drawCallback_ROUNDSQ,
+	&Graphics::VectorRenderer::drawCallback_BEVELSQ,
+	&Graphics::VectorRenderer::drawCallback_LINE,
+	&Graphics::VectorRenderer::drawCallback_TRIANGLE,
+	&Graphics::VectorRenderer::drawCallback_FILLSURFACE,
+	&Graphics::VectorRenderer::drawCallback_TAB,
+	&Graphics::VectorRenderer::drawCallback_VOID,
+	&Graphics::VectorRenderer::drawCallback_BITMAP,
+	&Graphics::VectorRenderer::drawCallback_CROSS
+};
+
+ThemeCache::ThemeCache() : _tick(0), _fileLoaded(false) {
+}
+
+ThemeCache::~ThemeCache() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		free(i->_value.data);
+}
+
+Common::SeekableReadStream *ThemeCache::find(const Common::String &key) {
+	if (!_fileLoaded)
+		loadFile();
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end())
+		return 0;
+
+	i->_value.lastUse = ++_tick;
+	return new Common::MemoryReadStream(i->_value.data, i->_value.size);
+}
+
+void ThemeCache::add(const Common::String &key, byte *data, uint32 size) {
+	if (!_fileLoaded)
+		loadFile();
+
+	if (_entries.contains(key))
+		free(_entries[key].data);
+
+	Entry &entry = _entries[key];
+	entry.data = data;
+	entry.size = size;
+	entry.lastUse = ++_tick;
+
+	while (_entries.size() > kMaxEntries) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		free(oldest->_value.data);
+		_entries.erase(oldest);
+	}
+
+	saveFile();
+}
+
+static Common::String readString(Common::ReadStream &in) {
+	Common::String str;
+	char buf[256];
+
+	for (uint32 len = in.readUint16LE(); len > 0; ) {
+		const uint32 chunk = MIN<uint32>(len, sizeof(buf));
+		const uint32 got = in.read(buf, chunk);
+		str += Common::String(buf, got);
+		if (got != chunk)
+			break;
+		len -= chunk;
+	}
+
+	return str;
+}
+
+void ThemeCache::writeString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint16LE(str.size());
+	out.write(str.c_str(), str.size());
+}
+
+static void writeColor(Common::WriteStream &out, const Graphics::DrawStep::Color &color) {
+	out.writeByte(color.r);
+	out.writeByte(color.g);
+	out.writeByte(color.b);
+	out.writeByte(color.set);
+}
+
+static void readColor(Common::ReadStream &in, Graphics::DrawStep::Color &color) {
+	color.r = in.readByte();
+	color.g = in.readByte();
+	color.b = in.readByte();
+	color.set = in.readByte() != 0;
+}
+
+void ThemeCache::writeDrawStep(Common::WriteStream &out, const Graphics::DrawStep &step, const Common::String &bitmap) {
+	writeColor(out, step.fgColor);
+	writeColor(out, step.bgColor);
+	writeColor(out, step.gradColor1);
+	writeColor(out, step.gradColor2);
+	writeColor(out, step.bevelColor);
+
+	out.writeByte(step.autoWidth);
+	out.writeByte(step.autoHeight);
+	out.writeSint16LE(step.x);
+	out.writeSint16LE(step.y);
+	out.writeSint16LE(step.w);
+	out.writeSint16LE(step.h);
+
+	out.writeSint16LE(step.padding.top);
+	out.writeSint16LE(step.padding.left);
+	out.writeSint16LE(step.padding.bottom);
+	out.writeSint16LE(step.padding.right);
+
+	out.writeByte(step.xAlign);
+	out.writeByte(step.yAlign);
+	out.writeByte(step.shadow);
+	out.writeByte(step.stroke);
+	out.writeByte(step.factor);
+	out.writeByte(step.radius);
+	out.writeByte(step.bevel);
+	out.writeByte(step.fillMode);
+	out.writeUint32LE(step.extraData);
+	out.writeUint32LE(step.scale);
+
+	uint call = 0;
+	while (call < ARRAYSIZE(kDrawingCalls) && kDrawingCalls[call] != step.drawingCall)
+		++call;
+	assert(call < ARRAYSIZE(kDrawingCalls));
+	out.writeByte(call);
+
+	writeString(out, bitmap);
+}
+
+static bool readDrawStep(Common::ReadStream &in, Graphics::DrawStep &step, ThemeEngine *theme) {
+	readColor(in, step.fgColor);
+	readColor(in, step.bgColor);
+	readColor(in, step.gradColor1);
+	readColor(in, step.gradColor2);
+	readColor(in, step.bevelColor);
+
+	step.autoWidth = in.readByte() != 0;
+	step.autoHeight = in.readByte() != 0;
+	step.x = in.readSint16LE();
+	step.y = in.readSint16LE();
+	step.w = in.readSint16LE();
+	step.h = in.readSint16LE();
+
+	step.padding.top = in.readSint16LE();
+	step.padding.left = in.readSint16LE();
+	step.padding.bottom = in.readSint16LE();
+	step.padding.right = in.readSint16LE();
+
+	step.xAlign = (Graphics::DrawStep::VectorAlignment)in.readByte();
+	step.yAlign = (Graphics::DrawStep::VectorAlignment)in.readByte();
+	step.shadow = in.readByte();
+	step.stroke = in.readByte();
+	step.factor = in.readByte();
+	step.radius = in.readByte();
+	step.bevel = in.readByte();
+	step.fillMode = in.readByte();
+	step.extraData = in.readUint32LE();
+	step.scale = in.readUint32LE();
+
+	uint call = in.readByte();
+	if (call >= ARRAYSIZE(kDrawingCalls))
+		return false;
+	step.drawingCall = kDrawingCalls[call];
+
+	Common::String bitmap = readString(in);
+	step.blitSrc = 0;
+	if (!bitmap.empty()) {
+		step.blitSrc = theme->getBitmap(bitmap);
+		if (!step.blitSrc)
+			return false;
+	}
+
+	return !in.eos() && !in.err();
+}
+
+bool ThemeCache::replay(ThemeEngine *theme, Common::SeekableReadStream &in) {
+	ThemeEval *eval = theme->getEvaluator();
+
+	for (;;) {
+		byte op = in.readByte();
+		if (in.eos() || in.err())
+			return false;
+
+		switch (op) {
+		case kThemeOpEnd:
+			return true;
+
+		case kThemeOpDrawData: {
+			Common::String id = readString(in);
+			bool cached = in.readByte() != 0;
+			if (!theme->addDrawData(id, cached))
+				return false;
+			break;
+		}
+
+		case kThemeOpDrawStep: {
+			Common::String id = readString(in);
+			Graphics::DrawStep step;
+			if (!readDrawStep(in, step, theme))
+				return false;
+			theme->addDrawStep(id, step);
+			break;
+		}
+
+		case kThemeOpFont: {
+			int textId = in.readSint32LE();
+			Common::String file = readString(in);
+			Common::String scalableFile = readString(in);
+			int pointsize = in.readSint32LE();
+			if (!theme->addFont((TextData)textId, file, scalableFile, pointsize))
+				return false;
+			break;
+		}
+
+		case kThemeOpTextColor: {
+			int colorId = in.readSint32LE();
+			int r = in.readByte();
+			int g = in.readByte();
+			int b = in.readByte();
+			if (!theme->addTextColor((TextColor)colorId, r, g, b))
+				return false;
+			break;
+		}
+
+		case kThemeOpBitmap:
+			if (!theme->addBitmap(readString(in)))
+				return false;
+			break;
+
+		case kThemeOpTextData: {
+			Common::String id = readString(in);
+			int textId = in.readSint32LE();
+			int colorId = in.readSint32LE();
+			int alignH = in.readSint32LE();
+			int alignV = in.readSint32LE();
+			if (!theme->addTextData(id, (TextData)textId, (TextColor)colorId, (Graphics::TextAlign)alignH, (ThemeEngine::TextAlignVertical)alignV))
+				return false;
+			break;
+		}
+
+		case kThemeOpCursor: {
+			Common::String file = readString(in);
+			int hotspotX = in.readSint32LE();
+			int hotspotY = in.readSint32LE();
+			if (!theme->createCursor(file, hotspotX, hotspotY))
+				return false;
+			break;
+		}
+
+		case kThemeOpSetVar: {
+			Common::String name = readString(in);
+			eval->setVar(name, in.readSint32LE());
+			break;
+		}
+
+		case kThemeOpDialog: {
+			Common::String name = readString(in);
+			Common::String overlays = readString(in);
+			bool enabled = in.readByte() != 0;
+			int inset = in.readSint32LE();
+			eval->addDialog(name, overlays, enabled, inset);
+			break;
+		}
+
+		case kThemeOpLayout: {
+			ThemeLayout::LayoutType type = (ThemeLayout::LayoutType)in.readByte();
+			int spacing = in.readSint32LE();
+			bool center = in.readByte() != 0;
+			eval->addLayout(type, spacing, center);
+			break;
+		}
+
+		case kThemeOpWidget: {
+			Common::String name = readString(in);
+			int w = in.readSint32LE();
+			int h = in.readSint32LE();
+			Common::String type = readString(in);
+			bool enabled = in.readByte() != 0;
+			int align = in.readSint32LE();
+			eval->addWidget(name, w, h, type, enabled, (Graphics::TextAlign)align);
+			break;
+		}
+
+		case kThemeOpImport:
+			if (!eval->addImportedLayout(readString(in)))
+				return false;
+			break;
+
+		case kThemeOpSpace:
+			eval->addSpace(in.readSint32LE());
+			break;
+
+		case kThemeOpPadding: {
+			int16 l = in.readSint16LE();
+			int16 r = in.readSint16LE();
+			int16 t = in.readSint16LE();
+			int16 b = in.readSint16LE();
+			eval->addPadding(l, r, t, b);
+			break;
+		}
+
+		case kThemeOpCloseLayout:
+			eval->closeLayout();
+			break;
+
+		case kThemeOpCloseDialog:
+			eval->closeDialog();
+			break;
+
+		default:
+			return false;
+		}
+	}
+}
+
+void ThemeCache::loadFile() {
+	_fileLoaded = true;
+
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return;
+
+	Common::InSaveFile *in = saveFileMan->openForLoading(kThemeCacheFileName);
+	if (!in)
+		return;
+
+	// Compiled themes depend on the parser which made them
+	if (in->readUint32BE() != kThemeCacheTag || readString(*in) != gScummVMFullVersion) {
+		delete in;
+		return;
+	}
+
+	uint32 count = in->readUint32LE();
+	while (count-- && !in->eos() && !in->err()) {
+		Common::String key = readString(*in);
+		uint32 lastUse = in->readUint32LE();
+		uint32 size = in->readUint32LE();
+
+		if (size > (uint32)(in->size() - in->pos()))
+			break;
+
+		byte *data = (byte *)malloc(size);
+		if (!data || in->read(data, size) != size) {
+			free(data);
+			break;
+		}
+
+		Entry &entry = _entries[key];
+		entry.data = data;
+		entry.size = size;
+		entry.lastUse = lastUse;
+		_tick = MAX(_tick, lastUse);
+	}
+
+	delete in;
+}
+
+void ThemeCache::saveFile() {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return;
+
+	Common::OutSaveFile *out = saveFileMan->openForSaving(kThemeCacheFileName, false);
+	if (!out)
+		return;
+
+	out->writeUint32BE(kThemeCacheTag);
+	writeString(*out, gScummVMFullVersion);
+	out->writeUint32LE(_entries.size());
+
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		writeString(*out, i->_key);
+		out->writeUint32LE(i->_value.lastUse);
+		out->writeUint32LE(i->_value.size);
+		out->write(i->_value.data, i->_value.size);
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Could not write the theme cache");
+	delete out;
+}
+
+} // End of namespace GUI
@@ -0,0 +1,139 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GUI_THEME_CACHE_H
+#define GUI_THEME_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/singleton.h"
+#include "common/stream.h"
+#include "common/str.h"
+
+namespace Graphics {
+struct DrawStep;
+}
+
+namespace GUI {
+
+class ThemeEngine;
+
+/**
+ * Operations recorded while parsing a theme, one byte each, followed by
+ * the arguments of the corresponding ThemeEngine or ThemeEval call.
+ */
+enum ThemeOpcode {
+	kThemeOpEnd = 0,
+
+	// ThemeEngine
+	kThemeOpDrawData,
+	kThemeOpDrawStep,
+	kThemeOpFont,
+	kThemeOpTextColor,
+	kThemeOpBitmap,
+	kThemeOpTextData,
+	kThemeOpCursor,
+
+	// ThemeEval
+	kThemeOpSetVar,
+	kThemeOpDialog,
+	kThemeOpLayout,
+	kThemeOpWidget,
+	kThemeOpImport,
+	kThemeOpSpace,
+	kThemeOpPadding,
+	kThemeOpCloseLayout,
+	kThemeOpCloseDialog
+};
+
+/**
+ * Cache of compiled themes.
+ *
+ * While the STX files of a theme are parsed, every call the ThemeParser
+ * makes into the ThemeEngine and its ThemeEval is recorded, with colors,
+ * variables and resolution specific sections already resolved. Loading
+ * the theme again at the same overlay size replays these calls instead
+ * of parsing the XML.
+ *
+ * Compiled themes are keyed by the theme id, the overlay size and the MD5
+ * of the theme files. The most recently used ones are kept in memory and
+ * in a file written through the save file manager.
+ */
+class ThemeCache : public Common::Singleton<ThemeCache> {
+	friend class Common::Singleton<SingletonBaseType>;
+	ThemeCache();
+	~ThemeCache();
+public:
+	/**
+	 * Open the compiled theme stored under the given key. The stream is
+	 * only valid until the next call to add().
+	 *
+	 * @return the compiled theme, or 0 if there is none for the key
+	 */
+	Common::SeekableReadStream *find(const Common::String &key);
+
+	/**
+	 * Store a compiled theme.
+	 *
+	 * @param key  the key the theme will be found under
+	 * @param data the compiled theme, allocated with malloc(); the cache
+	 *             takes ownership of it
+	 * @param size the size of the compiled theme
+	 */
+	void add(const Common::String &key, byte *data, uint32 size);
+
+	/**
+	 * Run the calls of a compiled theme against the given theme engine.
+	 *
+	 * @return false if the compiled theme is damaged or one of the calls
+	 *         failed
+	 */
+	static bool replay(ThemeEngine *theme, Common::SeekableReadStream &in);
+
+	static void writeString(Common::WriteStream &out, const Common::String &str);
+	static void writeDrawStep(Common::WriteStream &out, const Graphics::DrawStep &step, const Common::String &bitmap);
+
+private:
+	enum {
+		kMaxEntries = 4
+	};
+
+	struct Entry {
+		byte *data;
+		uint32 size;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void loadFile();
+	void saveFile();
+
+	EntryMap _entries;
+	uint32 _tick;
+	bool _fileLoaded;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -24,6 +24,8 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -37,6 +39,7 @@
 #include "graphics/decoders/bmp.h"
 
 #include "gui/widget.h"
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -75,6 +78,9 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the item looks the same wherever it is drawn, so it can be cached */
+	bool _cacheable;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -84,6 +90,13 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Checks whether the DrawData item can be kept in the DrawData cache.
+	 * Steps which fill the whole surface or scale their absolute position
+	 * depend on where the widget is, so items using them are never cached.
+	 */
+	void calcCacheable();
 };
 
 class ThemeItem {
@@ -223,11 +236,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawDD(_data, _area, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -267,7 +277,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
 	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(0) {
+	_cursor(0), _drawDataCacheSize(0), _drawDataCacheTick(0),
+	_drawDataCacheHits(0), _drawDataCacheMisses(0), _recorder(0) {
 
 	_system = g_system;
 	_parser = new ThemeParser(this);
@@ -312,6 +323,7 @@ ThemeEngine::~ThemeEngine() {
 	_backBuffer.free();
 
 	unloadTheme();
+	clearDrawDataCache();
 
 	// Release all graphics surfaces
 	for (ImagesMap::iterator i = _bitmaps.begin(); i != _bitmaps.end(); ++i) {
@@ -515,6 +527,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+
+	// The cached items were rendered for the old mode and format
+	clearDrawDataCache();
 }
 
 void WidgetDrawData::calcBackgroundOffset() {
@@ -531,6 +546,17 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_backgroundOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	_cacheable = true;
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE ||
+		        (step->scale != (1 << 16) && step->scale != 0))
+			_cacheable = false;
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
@@ -542,6 +568,21 @@ void ThemeEngine::restoreBackground(Common::Rect r) {
  * Theme elements management
  *********************************************************/
 void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::DrawStep &step) {
+	if (_recorder) {
+		// Bitmaps are stored by name
+		Common::String bitmap;
+		for (ImagesMap::const_iterator i = _bitmaps.begin(); i != _bitmaps.end() && step.blitSrc; ++i) {
+			if (i->_value == step.blitSrc) {
+				bitmap = i->_key;
+				break;
+			}
+		}
+
+		_recorder->writeByte(kThemeOpDrawStep);
+		ThemeCache::writeString(*_recorder, drawDataId);
+		ThemeCache::writeDrawStep(*_recorder, step, bitmap);
+	}
+
 	DrawData id = parseDrawDataId(drawDataId);
 
 	assert(_widgets[id] != 0);
@@ -549,6 +590,15 @@ void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::
 }
 
 bool ThemeEngine::addTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, TextAlignVertical alignV) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpTextData);
+		ThemeCache::writeString(*_recorder, drawDataId);
+		_recorder->writeSint32LE(textId);
+		_recorder->writeSint32LE(colorId);
+		_recorder->writeSint32LE(alignH);
+		_recorder->writeSint32LE(alignV);
+	}
+
 	DrawData id = parseDrawDataId(drawDataId);
 
 	if (id == -1 || textId == -1 || colorId == kTextColorMAX || !_widgets[id])
@@ -563,6 +613,14 @@ bool ThemeEngine::addTextData(const Common::String &drawDataId, TextData textId,
 }
 
 bool ThemeEngine::addFont(TextData textId, const Common::String &file, const Common::String &scalableFile, const int pointsize) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpFont);
+		_recorder->writeSint32LE(textId);
+		ThemeCache::writeString(*_recorder, file);
+		ThemeCache::writeString(*_recorder, scalableFile);
+		_recorder->writeSint32LE(pointsize);
+	}
+
 	if (textId == -1)
 		return false;
 
@@ -603,6 +661,14 @@ bool ThemeEngine::addFont(TextData textId, const Common::String &file, const Com
 }
 
 bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpTextColor);
+		_recorder->writeSint32LE(colorId);
+		_recorder->writeByte(r);
+		_recorder->writeByte(g);
+		_recorder->writeByte(b);
+	}
+
 	if (colorId >= kTextColorMAX)
 		return false;
 
@@ -619,6 +685,11 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 }
 
 bool ThemeEngine::addBitmap(const Common::String &filename) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpBitmap);
+		ThemeCache::writeString(*_recorder, filename);
+	}
+
 	// Nothing has to be done if the bitmap already has been loaded.
 	Graphics::Surface *surf = _bitmaps[filename];
 	if (surf)
@@ -650,6 +721,12 @@ bool ThemeEngine::addBitmap(const Common::String &filename) {
 }
 
 bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpDrawData);
+		ThemeCache::writeString(*_recorder, data);
+		_recorder->writeByte(cached);
+	}
+
 	DrawData id = parseDrawDataId(data);
 
 	if (id == -1)
@@ -691,6 +768,7 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 }
@@ -716,6 +794,9 @@ void ThemeEngine::unloadTheme() {
 
 	_themeEval->reset();
 	_themeOk = false;
+
+	// The cache is keyed by the DrawData items we just deleted
+	clearDrawDataCache();
 }
 
 bool ThemeEngine::loadDefaultXML() {
@@ -729,15 +810,22 @@ bool ThemeEngine::loadDefaultXML() {
 #include "themes/default.inc"
 	    ;
 
-	if (!_parser->loadBuffer((const byte *)defaultXML, strlen(defaultXML)))
-		return false;
-
 	_themeName = "ScummVM Classic Theme (Builtin Version)";
 	_themeId = "builtin";
 	_themeFile.clear();
 
+	Common::MemoryReadStream xml((const byte *)defaultXML, strlen(defaultXML));
+	const Common::String key = getCompiledThemeKey(_themeId, Common::computeStreamMD5AsString(xml));
+	if (loadCompiledTheme(key))
+		return true;
+
+	if (!_parser->loadBuffer((const byte *)defaultXML, strlen(defaultXML)))
+		return false;
+
+	startRecording();
 	bool result = _parser->parse();
 	_parser->close();
+	stopRecording(key, result);
 
 	return result;
 #else
@@ -775,29 +863,278 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	//
+	// Look for a compiled version of the STX files
+	//
+	Common::String hash;
+	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		if (stream) {
+			hash += (*i)->getName() + ":" + Common::computeStreamMD5AsString(*stream) + ";";
+			delete stream;
+		}
+	}
+
+	const Common::String key = getCompiledThemeKey(themeId, hash);
+	if (loadCompiledTheme(key))
+		return true;
+
 	//
 	// Loop over all STX files, load and parse them
 	//
+	bool result = true;
+	startRecording();
+
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
 		if (_parser->loadStream((*i)->createReadStream()) == false) {
 			warning("Failed to load STX file '%s'", (*i)->getDisplayName().c_str());
 			_parser->close();
-			return false;
+			result = false;
+			break;
 		}
 
 		if (_parser->parse() == false) {
 			warning("Failed to parse STX file '%s'", (*i)->getDisplayName().c_str());
 			_parser->close();
-			return false;
+			result = false;
+			break;
 		}
 
 		_parser->close();
 	}
 
-	assert(!_themeName.empty());
-	return true;
+	stopRecording(key, result);
+
+	assert(!result || !_themeName.empty());
+	return result;
+}
+
+/**
+ * Compiled themes depend on the overlay size, as the STX files contain
+ * resolution specific sections and layouts relative to the screen.
+ */
+Common::String ThemeEngine::getCompiledThemeKey(const Common::String &themeId, const Common::String &hash) const {
+	return Common::String::format("%s|%dx%d|", themeId.c_str(), _system->getOverlayWidth(), _system->getOverlayHeight()) + hash;
+}
+
+bool ThemeEngine::loadCompiledTheme(const Common::String &key) {
+	Common::SeekableReadStream *stream = ThemeCache::instance().find(key);
+	if (!stream)
+		return false;
+
+	debug(6, "Loading compiled theme %s", key.c_str());
+
+	bool result = ThemeCache::replay(this, *stream);
+	delete stream;
+
+	if (!result) {
+		warning("Failed to load the compiled theme, parsing it instead");
+
+		// Drop whatever the compiled theme loaded
+		_themeOk = true;
+		unloadTheme();
+	}
+
+	return result;
+}
+
+void ThemeEngine::startRecording() {
+	assert(!_recorder);
+	_recorder = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+	_themeEval->setRecorder(_recorder);
+}
+
+void ThemeEngine::stopRecording(const Common::String &key, bool parsed) {
+	assert(_recorder);
+	_themeEval->setRecorder(0);
+
+	if (parsed) {
+		_recorder->writeByte(kThemeOpEnd);
+		ThemeCache::instance().add(key, _recorder->getData(), _recorder->size());
+	} else {
+		free(_recorder->getData());
+	}
+
+	delete _recorder;
+	_recorder = 0;
+}
+
+
+
+/**********************************************************
+ * DrawData cache
+ *********************************************************/
+
+/** Bytes available for rasterized DrawData items */
+static const uint32 kDrawDataCacheMaxSize = 4 * 1024 * 1024;
+
+void ThemeEngine::drawDD(const WidgetDrawData *data, const Common::Rect &area, uint32 dynamic) {
+	Common::Rect extendedRect = area;
+	extendedRect.grow(kDirtyRectangleThreshold + data->_backgroundOffset);
+
+	// Items touching the screen border may be partly rejected by the
+	// renderer, which we can't reproduce from the cache.
+	Graphics::Surface *surface = _vectorRenderer->getSurface();
+	bool cacheable = data->_cacheable && _overlayFormat.bytesPerPixel == 2 && !extendedRect.isEmpty() &&
+	                 Common::Rect(surface->w, surface->h).contains(extendedRect) &&
+	                 !_system->hasFeature(OSystem::kFeatureOverlaySupportsAlpha);
+
+	if (cacheable) {
+		DrawDataCacheKey key;
+		key.data = data;
+		key.width = area.width();
+		key.height = area.height();
+		key.dynamicData = dynamic;
+		key.shadows = !_vectorRenderer->shadowsDisabled();
+
+		DrawDataCacheEntry *entry = _drawDataCache.getVal(key, 0);
+
+		if (entry) {
+			_drawDataCacheHits++;
+		} else {
+			_drawDataCacheMisses++;
+			entry = renderCachedDD(data, area, extendedRect, dynamic);
+
+			if (entry)
+				_drawDataCache[key] = entry;
+		}
+
+		if (entry) {
+			entry->lastUse = ++_drawDataCacheTick;
+			blitCachedDD(entry, extendedRect);
+			return;
+		}
+	}
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+		_vectorRenderer->drawStep(area, *step, dynamic);
+}
+
+ThemeEngine::DrawDataCacheEntry *ThemeEngine::renderCachedDD(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic) {
+	const int w = extendedRect.width();
+	const int h = extendedRect.height();
+	const uint32 entrySize = w * h * (_overlayFormat.bytesPerPixel + 1);
+
+	// Leave room for other items, big backgrounds would evict everything else
+	if (entrySize > kDrawDataCacheMaxSize / 4)
+		return 0;
+
+	// Make room for the new entry, evicting the least recently used items
+	while (_drawDataCacheSize + entrySize > kDrawDataCacheMaxSize) {
+		DrawDataCache::iterator oldest = _drawDataCache.begin();
+		for (DrawDataCache::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+			if (i->_value->lastUse < oldest->_value->lastUse)
+				oldest = i;
+		}
+
+		DrawDataCacheEntry *old = oldest->_value;
+		_drawDataCacheSize -= old->surface.w * old->surface.h * (old->surface.format.bytesPerPixel + 1);
+		old->surface.free();
+		delete[] old->coverage;
+		delete old;
+		_drawDataCache.erase(oldest);
+	}
+
+	const uint16 black = _overlayFormat.RGBToColor(0, 0, 0);
+	const uint16 white = _overlayFormat.RGBToColor(255, 255, 255);
+
+	Graphics::Surface overBlack, overWhite;
+	overBlack.create(w, h, _overlayFormat);
+	overWhite.create(w, h, _overlayFormat);
+
+	Common::Rect localArea = area;
+	localArea.translate(-extendedRect.left, -extendedRect.top);
+
+	Graphics::Surface *activeSurface = _vectorRenderer->getSurface();
+
+	Graphics::Surface *targets[] = { &overBlack, &overWhite };
+	for (int i = 0; i < 2; i++) {
+		targets[i]->fillRect(Common::Rect(w, h), (i == 0) ? black : white);
+		_vectorRenderer->setSurface(targets[i]);
+
+		Common::List<Graphics::DrawStep>::const_iterator step;
+		for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+			_vectorRenderer->drawStep(localArea, *step, dynamic);
+	}
+
+	_vectorRenderer->setSurface(activeSurface);
+
+	DrawDataCacheEntry *entry = new DrawDataCacheEntry();
+	entry->surface = overBlack;
+	entry->coverage = new byte[w * h];
+
+	byte *coverage = entry->coverage;
+	for (int y = 0; y < h; y++) {
+		const uint16 *b = (const uint16 *)overBlack.getBasePtr(0, y);
+		const uint16 *wh = (const uint16 *)overWhite.getBasePtr(0, y);
+
+		for (int x = 0; x < w; x++, b++, wh++, coverage++) {
+			if (*b == black && *wh == white) {
+				*coverage = 255;
+			} else if (*b == *wh) {
+				*coverage = 0;
+			} else {
+				// The difference between both renderings tells how much of
+				// the background shows through. Take the smallest amount of
+				// all components so that compositing can never overflow.
+				byte r0, g0, b0, r1, g1, b1;
+				_overlayFormat.colorToRGB(*b, r0, g0, b0);
+				_overlayFormat.colorToRGB(*wh, r1, g1, b1);
+
+				int amount = MIN<int>(r1 - r0, MIN<int>(g1 - g0, b1 - b0));
+				*coverage = CLIP<int>(amount, 1, 254);
+			}
+		}
+	}
+
+	overWhite.free();
+
+	_drawDataCacheSize += entrySize;
+	return entry;
+}
+
+void ThemeEngine::blitCachedDD(const DrawDataCacheEntry *entry, const Common::Rect &extendedRect) {
+	Graphics::Surface *surface = _vectorRenderer->getSurface();
+	const byte *coverage = entry->coverage;
+
+	for (int y = 0; y < entry->surface.h; y++) {
+		const uint16 *src = (const uint16 *)entry->surface.getBasePtr(0, y);
+		uint16 *dst = (uint16 *)surface->getBasePtr(extendedRect.left, extendedRect.top + y);
+
+		for (int x = 0; x < entry->surface.w; x++, src++, dst++, coverage++) {
+			if (*coverage == 0) {
+				*dst = *src;
+			} else if (*coverage != 255) {
+				byte r0, g0, b0, r, g, b;
+				_overlayFormat.colorToRGB(*src, r0, g0, b0);
+				_overlayFormat.colorToRGB(*dst, r, g, b);
+
+				*dst = _overlayFormat.RGBToColor(r0 + r * *coverage / 255,
+				                                 g0 + g * *coverage / 255,
+				                                 b0 + b * *coverage / 255);
+			}
+		}
+	}
+}
+
+void ThemeEngine::clearDrawDataCache() {
+	if (!_drawDataCache.empty())
+		debug(6, "Clearing DrawData cache: %d items, %d bytes, %d hits, %d misses",
+		      _drawDataCache.size(), _drawDataCacheSize, _drawDataCacheHits, _drawDataCacheMisses);
+
+	for (DrawDataCache::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i) {
+		i->_value->surface.free();
+		delete[] i->_value->coverage;
+		delete i->_value;
+	}
+
+	_drawDataCache.clear();
+	_drawDataCacheSize = 0;
+	_drawDataCacheHits = 0;
+	_drawDataCacheMisses = 0;
 }
 
 
@@ -1290,6 +1627,13 @@ void ThemeEngine::openDialog(bool doBuffer, ShadingStyle style) {
 }
 
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpCursor);
+		ThemeCache::writeString(*_recorder, filename);
+		_recorder->writeSint32LE(hotspotX);
+		_recorder->writeSint32LE(hotspotY);
+	}
+
 	if (!_system->hasFeature(OSystem::kFeatureCursorPalette))
 		return true;
 
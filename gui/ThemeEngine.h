@@ -41,6 +41,7 @@ class OSystem;
 
 namespace Common {
 struct Rect;
+class MemoryWriteStreamDynamic;
 }
 
 namespace Graphics {
@@ -144,6 +145,40 @@ class ThemeEngine {
 protected:
 	typedef Common::HashMap<Common::String, Graphics::Surface *> ImagesMap;
 
+	/** Identifies a rasterized DrawData item in the DrawData cache. */
+	struct DrawDataCacheKey {
+		const WidgetDrawData *data;
+		int16 width, height;
+		uint32 dynamicData;
+		bool shadows;
+
+		bool operator==(const DrawDataCacheKey &other) const {
+			return data == other.data && width == other.width && height == other.height &&
+			       dynamicData == other.dynamicData && shadows == other.shadows;
+		}
+	};
+
+	struct DrawDataCacheKey_Hash {
+		uint operator()(const DrawDataCacheKey &key) const {
+			return (uint)(size_t)key.data ^ (key.width << 20) ^ (key.height << 8) ^ key.dynamicData ^ (key.shadows ? 1 : 0);
+		}
+	};
+
+	/**
+	 * A DrawData item rendered once over a black and once over a white
+	 * background. Pixels which came out the same are opaque, pixels which
+	 * were left alone are transparent, and the rest were blended with the
+	 * background. For those, the amount of background showing through is
+	 * stored, so the item can be composited over any background again.
+	 */
+	struct DrawDataCacheEntry {
+		Graphics::Surface surface; ///< Colors over the black background
+		byte *coverage;            ///< 0 = opaque, 255 = transparent, blend amount otherwise
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<DrawDataCacheKey, DrawDataCacheEntry *, DrawDataCacheKey_Hash> DrawDataCache;
+
 	friend class GUI::Dialog;
 	friend class GUI::GuiObject;
 
@@ -513,6 +548,17 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws all steps of a DrawData item in the given area. Items which
+	 * don't depend on their position on screen are rendered only once
+	 * per size and state and blitted from the DrawData cache afterwards.
+	 *
+	 * @param data    The DrawData item to draw.
+	 * @param area    Area of the widget.
+	 * @param dynamic Dynamic data passed to the draw steps.
+	 */
+	void drawDD(const WidgetDrawData *data, const Common::Rect &area, uint32 dynamic);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -543,12 +589,39 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/** Key of a compiled theme in the ThemeCache. */
+	Common::String getCompiledThemeKey(const Common::String &themeId, const Common::String &hash) const;
+
+	/**
+	 * Load the theme compiled under the given key from the ThemeCache.
+	 * Returns false if there is none or it fails to load.
+	 */
+	bool loadCompiledTheme(const Common::String &key);
+
+	/** Start recording the calls made by the theme parser. */
+	void startRecording();
+
+	/** Stop recording and store the recorded theme if it was parsed successfully. */
+	void stopRecording(const Common::String &key, bool parsed);
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
 	 */
 	void unloadTheme();
 
+	/**
+	 * Renders a DrawData item into a new DrawData cache entry.
+	 * Returns 0 if the item can't be cached.
+	 */
+	DrawDataCacheEntry *renderCachedDD(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic);
+
+	/** Blits a DrawData cache entry to the active drawing surface. */
+	void blitCachedDD(const DrawDataCacheEntry *entry, const Common::Rect &extendedRect);
+
+	/** Frees all rasterized DrawData items, e.g. on theme or resolution changes. */
+	void clearDrawDataCache();
+
 	const Graphics::Font *loadScalableFont(const Common::String &filename, const Common::String &charset, const int pointsize, Common::String &name);
 	const Graphics::Font *loadFont(const Common::String &filename, Common::String &name);
 	Common::String genCacheFilename(const Common::String &filename) const;
@@ -616,6 +689,9 @@ protected:
 	/** Theme getEvaluator (changed from GUI::Eval to add functionality) */
 	GUI::ThemeEval *_themeEval;
 
+	/** Stream the parsed theme is recorded to, if any. @see ThemeCache */
+	Common::MemoryWriteStreamDynamic *_recorder;
+
 	/** Main screen surface. This is blitted straight into the overlay. */
 	Graphics::Surface _screen;
 
@@ -663,6 +739,13 @@ protected:
 	/** Queue with all the drawing that must be done to the screen */
 	Common::List<ThemeItem *> _screenQueue;
 
+	/** Rasterized DrawData items, see drawDD() */
+	DrawDataCache _drawDataCache;
+	uint32 _drawDataCacheSize;   ///< Bytes used by the cached items
+	uint32 _drawDataCacheTick;   ///< Counter used for LRU eviction
+	uint32 _drawDataCacheHits;
+	uint32 _drawDataCacheMisses;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
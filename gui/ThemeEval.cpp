@@ -21,6 +21,7 @@
  */
 
 #include "gui/ThemeEval.h"
+#include "gui/ThemeCache.h"
 
 #include "graphics/scaler.h"
 
@@ -48,9 +49,16 @@ void ThemeEval::reset() {
 		delete i->_value;
 
 	_layouts.clear();
+	_widgets.clear();
 }
 
-bool ThemeEval::getWidgetData(const Common::String &widget, int16 &x, int16 &y, uint16 &w, uint16 &h) {
+const ThemeEval::WidgetData &ThemeEval::resolveWidget(const Common::String &widget) {
+	// Widgets are looked up by name each time a dialog is reflowed, so
+	// remember where the name led to
+	WidgetsMap::const_iterator i = _widgets.find(widget);
+	if (i != _widgets.end())
+		return i->_value;
+
 	Common::StringTokenizer tokenizer(widget, ".");
 
 	if (widget.hasPrefix("Dialog."))
@@ -59,28 +67,57 @@ bool ThemeEval::getWidgetData(const Common::String &widget, int16 &x, int16 &y,
 	Common::String dialogName = "Dialog." + tokenizer.nextToken();
 	Common::String widgetName = tokenizer.nextToken();
 
-	if (!_layouts.contains(dialogName))
-		return false;
+	WidgetData &data = _widgets[widget];
+	data.found = false;
+	data.align = Graphics::kTextAlignInvalid;
+
+	LayoutsMap::const_iterator layout = _layouts.find(dialogName);
+	if (layout != _layouts.end()) {
+		data.found = layout->_value->getWidgetData(widgetName, data.x, data.y, data.w, data.h);
+		data.align = layout->_value->getWidgetTextHAlign(widgetName);
+	}
 
-	return _layouts[dialogName]->getWidgetData(widgetName, x, y, w, h);
+	return data;
 }
 
-Graphics::TextAlign ThemeEval::getWidgetTextHAlign(const Common::String &widget) {
-	Common::StringTokenizer tokenizer(widget, ".");
+bool ThemeEval::getWidgetData(const Common::String &widget, int16 &x, int16 &y, uint16 &w, uint16 &h) {
+	const WidgetData &data = resolveWidget(widget);
 
-	if (widget.hasPrefix("Dialog."))
-		tokenizer.nextToken();
+	if (!data.found)
+		return false;
 
-	Common::String dialogName = "Dialog." + tokenizer.nextToken();
-	Common::String widgetName = tokenizer.nextToken();
+	x = data.x;
+	y = data.y;
+	w = data.w;
+	h = data.h;
+	return true;
+}
 
-	if (!_layouts.contains(dialogName))
-		return Graphics::kTextAlignInvalid;
+Graphics::TextAlign ThemeEval::getWidgetTextHAlign(const Common::String &widget) {
+	return resolveWidget(widget).align;
+}
 
-	return _layouts[dialogName]->getWidgetTextHAlign(widgetName);
+void ThemeEval::setVar(const Common::String &name, int val) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpSetVar);
+		ThemeCache::writeString(*_recorder, name);
+		_recorder->writeSint32LE(val);
+	}
+
+	_vars[name] = val;
 }
 
 void ThemeEval::addWidget(const Common::String &name, int w, int h, const Common::String &type, bool enabled, Graphics::TextAlign align) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpWidget);
+		ThemeCache::writeString(*_recorder, name);
+		_recorder->writeSint32LE(w);
+		_recorder->writeSint32LE(h);
+		ThemeCache::writeString(*_recorder, type);
+		_recorder->writeByte(enabled);
+		_recorder->writeSint32LE(align);
+	}
+
 	int typeW = -1;
 	int typeH = -1;
 	Graphics::TextAlign typeAlign = Graphics::kTextAlignInvalid;
@@ -97,10 +134,18 @@ void ThemeEval::addWidget(const Common::String &name, int w, int h, const Common
 								typeAlign == Graphics::kTextAlignInvalid ? align : typeAlign);
 
 	_curLayout.top()->addChild(widget);
-	setVar(_curDialog + "." + name + ".Enabled", enabled ? 1 : 0);
+	_vars[_curDialog + "." + name + ".Enabled"] = enabled ? 1 : 0;
 }
 
 void ThemeEval::addDialog(const Common::String &name, const Common::String &overlays, bool enabled, int inset) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpDialog);
+		ThemeCache::writeString(*_recorder, name);
+		ThemeCache::writeString(*_recorder, overlays);
+		_recorder->writeByte(enabled);
+		_recorder->writeSint32LE(inset);
+	}
+
 	int16 x, y;
 	uint16 w, h;
 
@@ -121,6 +166,7 @@ void ThemeEval::addDialog(const Common::String &name, const Common::String &over
 		delete _layouts[name];
 
 	_layouts[name] = layout;
+	_widgets.clear();
 
 	layout->setPadding(
 		getVar("Globals.Padding.Left", 0),
@@ -131,10 +177,17 @@ void ThemeEval::addDialog(const Common::String &name, const Common::String &over
 
 	_curLayout.push(layout);
 	_curDialog = name;
-	setVar(name + ".Enabled", enabled ? 1 : 0);
+	_vars[name + ".Enabled"] = enabled ? 1 : 0;
 }
 
 void ThemeEval::addLayout(ThemeLayout::LayoutType type, int spacing, bool center) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpLayout);
+		_recorder->writeByte(type);
+		_recorder->writeSint32LE(spacing);
+		_recorder->writeByte(center);
+	}
+
 	ThemeLayout *layout = 0;
 
 	if (spacing == -1)
@@ -156,11 +209,49 @@ void ThemeEval::addLayout(ThemeLayout::LayoutType type, int spacing, bool center
 }
 
 void ThemeEval::addSpace(int size) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpSpace);
+		_recorder->writeSint32LE(size);
+	}
+
 	ThemeLayout *space = new ThemeLayoutSpacing(_curLayout.top(), size);
 	_curLayout.top()->addChild(space);
 }
 
+void ThemeEval::addPadding(int16 l, int16 r, int16 t, int16 b) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpPadding);
+		_recorder->writeSint16LE(l);
+		_recorder->writeSint16LE(r);
+		_recorder->writeSint16LE(t);
+		_recorder->writeSint16LE(b);
+	}
+
+	_curLayout.top()->setPadding(l, r, t, b);
+}
+
+void ThemeEval::closeLayout() {
+	if (_recorder)
+		_recorder->writeByte(kThemeOpCloseLayout);
+
+	_curLayout.pop();
+}
+
+void ThemeEval::closeDialog() {
+	if (_recorder)
+		_recorder->writeByte(kThemeOpCloseDialog);
+
+	_curLayout.pop()->reflowLayout();
+	_curDialog.clear();
+	_widgets.clear();
+}
+
 bool ThemeEval::addImportedLayout(const Common::String &name) {
+	if (_recorder) {
+		_recorder->writeByte(kThemeOpImport);
+		ThemeCache::writeString(*_recorder, name);
+	}
+
 	if (!_layouts.contains(name))
 		return false;
 
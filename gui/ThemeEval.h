@@ -28,6 +28,7 @@
 #include "common/hash-str.h"
 #include "common/stack.h"
 #include "common/str.h"
+#include "common/stream.h"
 #include "common/textconsole.h"
 #include "graphics/font.h"
 
@@ -40,8 +41,17 @@ class ThemeEval {
 	typedef Common::HashMap<Common::String, int> VariablesMap;
 	typedef Common::HashMap<Common::String, ThemeLayout *> LayoutsMap;
 
+	/** Resolved position and alignment of a widget in a closed dialog */
+	struct WidgetData {
+		bool found;
+		int16 x, y;
+		uint16 w, h;
+		Graphics::TextAlign align;
+	};
+	typedef Common::HashMap<Common::String, WidgetData> WidgetsMap;
+
 public:
-	ThemeEval() {
+	ThemeEval() : _recorder(0) {
 		buildBuiltinVars();
 	}
 
@@ -70,7 +80,7 @@ public:
 		return def;
 	}
 
-	void setVar(const Common::String &name, int val) { _vars[name] = val; }
+	void setVar(const Common::String &name, int val);
 
 	bool hasVar(const Common::String &name) { return _vars.contains(name) || _builtin.contains(name); }
 
@@ -80,10 +90,10 @@ public:
 	bool addImportedLayout(const Common::String &name);
 	void addSpace(int size);
 
-	void addPadding(int16 l, int16 r, int16 t, int16 b) { _curLayout.top()->setPadding(l, r, t, b); }
+	void addPadding(int16 l, int16 r, int16 t, int16 b);
 
-	void closeLayout() { _curLayout.pop(); }
-	void closeDialog() { _curLayout.pop()->reflowLayout(); _curDialog.clear(); }
+	void closeLayout();
+	void closeDialog();
 
 	bool getWidgetData(const Common::String &widget, int16 &x, int16 &y, uint16 &w, uint16 &h);
 
@@ -97,11 +107,21 @@ public:
 
 	void reset();
 
+	/**
+	 * Record all calls which build the layouts to the given stream.
+	 * @see ThemeCache
+	 */
+	void setRecorder(Common::WriteStream *recorder) { _recorder = recorder; }
+
 private:
+	const WidgetData &resolveWidget(const Common::String &widget);
+
 	VariablesMap _vars;
 	VariablesMap _builtin;
 
 	LayoutsMap _layouts;
+	WidgetsMap _widgets;
+	Common::WriteStream *_recorder;
 	Common::Stack<ThemeLayout *> _curLayout;
 	Common::String _curDialog;
 };
@@ -17,6 +17,7 @@ MODULE_OBJS := \
 	saveload.o \
 	saveload-dialog.o \
 	themebrowser.o \
+	ThemeCache.o \
 	ThemeEngine.o \
 	ThemeEval.o \
 	ThemeLayout.o \
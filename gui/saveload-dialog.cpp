@@ -22,6 +22,8 @@
 #include "gui/saveload-dialog.h"
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
+#include "common/system.h"
 
 #include "gui/message.h"
 #include "gui/gui-manager.h"
@@ -30,8 +32,63 @@
 
 #include "graphics/scaler.h"
 
+namespace Common {
+DECLARE_SINGLETON(GUI::SaveStateCache);
+}
+
 namespace GUI {
 
+SaveStateCache::SaveStateCache() : _tick(0), _changeCount(0) {
+}
+
+void SaveStateCache::validate() {
+	const Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (!saveFileMan)
+		return;
+
+	const uint32 changeCount = saveFileMan->getChangeCount();
+	if (changeCount != _changeCount) {
+		_entries.clear();
+		_changeCount = changeCount;
+	}
+}
+
+bool SaveStateCache::find(const Common::String &target, int slot, SaveStateDescriptor &desc) {
+	validate();
+
+	EntryMap::iterator i = _entries.find(Common::String::format("%s#%d", target.c_str(), slot));
+	if (i == _entries.end())
+		return false;
+
+	i->_value.lastUse = ++_tick;
+	desc = i->_value.desc;
+	return true;
+}
+
+SaveStateDescriptor SaveStateCache::query(const MetaEngine *metaEngine, const Common::String &target, int slot) {
+	SaveStateDescriptor desc;
+	if (find(target, slot, desc))
+		return desc;
+
+	desc = metaEngine->querySaveMetaInfos(target.c_str(), slot);
+
+	Entry &entry = _entries[Common::String::format("%s#%d", target.c_str(), slot)];
+	entry.desc = desc;
+	entry.lastUse = ++_tick;
+
+	while (_entries.size() > kMaxEntries) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		_entries.erase(oldest);
+	}
+
+	return desc;
+}
+
 #ifndef DISABLE_SAVELOADCHOOSER_GRID
 SaveLoadChooserType getRequestedSaveLoadDialog(const MetaEngine &metaEngine) {
 	const Common::String &userConfig = ConfMan.get("gui_saveload_chooser", Common::ConfigManager::kApplicationDomain);
@@ -360,7 +417,7 @@ void SaveLoadChooserSimple::updateSelection(bool redraw) {
 	_playtime->setLabel(_("No playtime saved"));
 
 	if (selItem >= 0 && _metaInfoSupport) {
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[selItem].getSaveSlot());
+		SaveStateDescriptor desc = SaveStateCache::instance().query(_metaEngine, _target, _saveList[selItem].getSaveSlot());
 
 		isDeletable = desc.getDeletableFlag() && _delSupport;
 		isWriteProtected = desc.getWriteProtectedFlag();
@@ -534,6 +591,12 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+enum {
+	// Upper bound (in milliseconds) we want to spend loading save state
+	// meta infos in handleTickle.
+	kMaxLoadTime = 20
+};
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
@@ -786,6 +849,7 @@ void SaveLoadChooserGrid::close() {
 
 	SaveLoadChooserDialog::close();
 	hideButtons();
+	_pendingSaves.clear();
 }
 
 int SaveLoadChooserGrid::runIntern() {
@@ -845,56 +909,92 @@ void SaveLoadChooserGrid::hideButtons() {
 	}
 }
 
-void SaveLoadChooserGrid::updateSaves() {
-	hideButtons();
+void SaveLoadChooserGrid::handleTickle() {
+	if (!_pendingSaves.empty()) {
+		const uint32 start = g_system->getMillis();
+
+		// Load the meta infos of the visible saves one after another, so
+		// the dialog stays responsive while the thumbnails trickle in.
+		do {
+			const uint i = _pendingSaves.front();
+			_pendingSaves.remove_at(0);
+
+			SlotButton &curButton = _buttons[i - _curPage * _entriesPerPage];
+			const int saveSlot = _saveList[i].getSaveSlot();
+			updateButton(curButton, saveSlot, SaveStateCache::instance().query(_metaEngine, _target, saveSlot), true);
+			curButton.container->draw();
+		} while (!_pendingSaves.empty() && g_system->getMillis() - start < kMaxLoadTime);
+	}
 
-	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+	SaveLoadChooserDialog::handleTickle();
+}
 
-		SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+void SaveLoadChooserGrid::updateButton(SlotButton &button, int saveSlot, const SaveStateDescriptor &desc, bool loaded) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		button.button->setGfx(thumbnail);
+	} else {
+		button.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	button.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
 
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
 
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
+		}
 
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
 		}
+	}
 
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
 		}
+	}
+
+	button.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected. Until
+	// the meta infos are loaded we do not know whether it is.
+	// TODO: Maybe we should not display it at all then?
+	if (_saveMode && (!loaded || desc.getWriteProtectedFlag())) {
+		button.button->setEnabled(false);
+	} else {
+		button.button->setEnabled(true);
+	}
+}
 
-		curButton.button->setTooltip(tooltip);
+void SaveLoadChooserGrid::updateSaves() {
+	hideButtons();
+	_pendingSaves.clear();
+
+	SaveStateCache &cache = SaveStateCache::instance();
+
+	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
+		SlotButton &curButton = _buttons[curNum];
+		curButton.setVisible(true);
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
+		// Saves whose meta infos are not cached yet are shown with the
+		// description from the save list and an empty thumbnail for now.
+		// Their meta infos are loaded in handleTickle.
+		const int saveSlot = _saveList[i].getSaveSlot();
+		SaveStateDescriptor desc;
+		if (cache.find(_target, saveSlot, desc)) {
+			updateButton(curButton, saveSlot, desc, true);
 		} else {
-			curButton.button->setEnabled(true);
+			updateButton(curButton, saveSlot, _saveList[i], false);
+			_pendingSaves.push_back(i);
 		}
 	}
 
@@ -25,6 +25,10 @@
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/singleton.h"
+
 #include "engines/metaengine.h"
 
 namespace GUI {
@@ -48,6 +52,51 @@ enum SaveLoadChooserType {
 SaveLoadChooserType getRequestedSaveLoadDialog(const MetaEngine &metaEngine);
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
 
+/**
+ * Cache of save state meta infos, including their thumbnails.
+ *
+ * Querying the meta infos of a save state usually means opening and
+ * decompressing the save file, which adds up quickly when a save/load
+ * dialog shows many of them. The most recently used meta infos are kept
+ * here across dialog openings. The whole cache is dropped as soon as any
+ * savefile was written or removed.
+ */
+class SaveStateCache : public Common::Singleton<SaveStateCache> {
+	friend class Common::Singleton<SingletonBaseType>;
+	SaveStateCache();
+public:
+	/**
+	 * Look up the cached meta infos of a save state.
+	 *
+	 * @return true if the meta infos were cached, false otherwise
+	 */
+	bool find(const Common::String &target, int slot, SaveStateDescriptor &desc);
+
+	/**
+	 * Query the meta infos of a save state, going through the meta engine
+	 * if they are not cached yet.
+	 */
+	SaveStateDescriptor query(const MetaEngine *metaEngine, const Common::String &target, int slot);
+
+private:
+	enum {
+		kMaxEntries = 64
+	};
+
+	struct Entry {
+		SaveStateDescriptor desc;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void validate();
+
+	EntryMap _entries;
+	uint32 _tick;
+	uint32 _changeCount;
+};
+
 class SaveLoadChooserDialog : protected Dialog {
 public:
 	SaveLoadChooserDialog(const Common::String &dialogName, const bool saveMode);
@@ -163,6 +212,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 private:
 	virtual int runIntern();
 
@@ -171,6 +221,9 @@ private:
 	uint _curPage;
 	SaveStateList _saveList;
 
+	/** Indices into _saveList of visible saves whose meta infos are not loaded yet. */
+	Common::Array<uint> _pendingSaves;
+
 	ButtonWidget *_nextButton;
 	ButtonWidget *_prevButton;
 
@@ -200,6 +253,7 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateButton(SlotButton &button, int saveSlot, const SaveStateDescriptor &desc, bool loaded);
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
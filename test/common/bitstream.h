@@ -2,6 +2,11 @@
 
 #include "common/bitstream.h"
 #include "common/memstream.h"
+#include "common/str.h"
+
+#ifdef POSIX
+#include <sys/time.h>
+#endif
 
 class BitStreamTestSuite : public CxxTest::TestSuite
 {
@@ -149,4 +154,181 @@ class BitStreamTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(bs.peekBits(5), 12u);
 		TS_ASSERT(!bs.eos());
 	}
+
+	void test_memory_get_bits() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::BitStreamMemory8MSB bs(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		TS_ASSERT_EQUALS(bs.getBits(3), 3u);
+		TS_ASSERT_EQUALS(bs.pos(), 3u);
+		TS_ASSERT_EQUALS(bs.getBits(8), 11u);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT(!bs.eos());
+		TS_ASSERT_EQUALS(bs.getBits(5), 2u);
+		TS_ASSERT(bs.eos());
+	}
+
+	void test_memory_get_bits_lsb() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::BitStreamMemory8LSB bs(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(bs.getBits(3), 1u);
+		TS_ASSERT_EQUALS(bs.getBits(8), 76u);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT_EQUALS(bs.getBits(5), 12u);
+		TS_ASSERT(bs.eos());
+	}
+
+	void test_memory_peek_skip_rewind() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::BitStreamMemory8MSB bs(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(bs.peekBits(3), 3u);
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		bs.skip(11);
+		TS_ASSERT_EQUALS(bs.peekBits(5), 2u);
+		// Peeking past the end reads zero bits
+		TS_ASSERT_EQUALS(bs.peekBits(8), 16u);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		bs.rewind();
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		TS_ASSERT_EQUALS(bs.getBits(3), 3u);
+		TS_ASSERT_EQUALS(bs.size(), 16u);
+	}
+
+	template<class MEMORY, class STREAM>
+	void checkMemoryMatchesStream(const byte *data, uint32 size) {
+		Common::MemoryReadStream ms(data, size);
+		STREAM bs(ms);
+		MEMORY mbs(data, size);
+
+		TS_ASSERT_EQUALS(mbs.size(), bs.size());
+
+		// Mixed read widths, including full 32-bit reads and long skips
+		uint32 n = 1;
+		while (bs.size() - bs.pos() >= 32) {
+			if (n % 7 == 0) {
+				bs.skip(n * 3);
+				mbs.skip(n * 3);
+			} else {
+				TS_ASSERT_EQUALS(mbs.peekBits(n), bs.peekBits(n));
+				TS_ASSERT_EQUALS(mbs.getBits(n), bs.getBits(n));
+			}
+			TS_ASSERT_EQUALS(mbs.pos(), bs.pos());
+
+			n = (n % 32) + 1;
+		}
+	}
+
+	void test_memory_matches_stream() {
+		byte contents[4099];
+		uint32 seed = 0x12345678;
+		for (uint32 i = 0; i < sizeof(contents); i++) {
+			seed = seed * 1103515245 + 12345;
+			contents[i] = seed >> 24;
+		}
+
+		checkMemoryMatchesStream<Common::BitStreamMemory8MSB,    Common::BitStream8MSB   >(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory8LSB,    Common::BitStream8LSB   >(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory16LEMSB, Common::BitStream16LEMSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory16LELSB, Common::BitStream16LELSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory16BEMSB, Common::BitStream16BEMSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory16BELSB, Common::BitStream16BELSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory32LEMSB, Common::BitStream32LEMSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory32LELSB, Common::BitStream32LELSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory32BEMSB, Common::BitStream32BEMSB>(contents, sizeof(contents));
+		checkMemoryMatchesStream<Common::BitStreamMemory32BELSB, Common::BitStream32BELSB>(contents, sizeof(contents));
+	}
+
+	// Throughput benchmarks. They also check that both readers return the
+	// same bits, the timings are only reported as a trace.
+
+	static uint32 getMicros() {
+#ifdef POSIX
+		timeval tv;
+		gettimeofday(&tv, 0);
+		return (uint32)(tv.tv_sec * 1000000 + tv.tv_usec);
+#else
+		return 0;
+#endif
+	}
+
+	static void traceThroughput(const char *name, uint32 bytes, uint32 micros) {
+		if (micros == 0)
+			micros = 1;
+		TS_TRACE(Common::String::format("%s: %d KB in %d us (%d KB/s)", name,
+			bytes / 1024, micros, (uint32)((uint64)bytes * 1000000 / 1024 / micros)).c_str());
+	}
+
+	enum {
+		kBenchmarkSize = 1024 * 1024
+	};
+
+	static byte *createBenchmarkData() {
+		byte *data = new byte[kBenchmarkSize];
+		uint32 seed = 0x87654321;
+		for (uint32 i = 0; i < kBenchmarkSize; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 24;
+		}
+		return data;
+	}
+
+	template<class BITSTREAM>
+	static uint32 benchmarkGetBit(BITSTREAM &bs) {
+		uint32 sum = 0;
+		while (bs.size() - bs.pos() >= 1)
+			sum = (sum << 1 | sum >> 31) ^ bs.getBit();
+		return sum;
+	}
+
+	template<class BITSTREAM>
+	static uint32 benchmarkGetBits(BITSTREAM &bs) {
+		// Widths typical for VLC and coefficient reads
+		static const uint8 widths[] = { 1, 3, 5, 8, 2, 13, 7, 16, 4, 11 };
+
+		uint32 sum = 0, i = 0;
+		while (bs.size() - bs.pos() >= 16) {
+			sum = (sum << 1 | sum >> 31) ^ bs.getBits(widths[i]);
+			i = (i + 1) % ARRAYSIZE(widths);
+		}
+		return sum;
+	}
+
+	void test_benchmark_get_bit() {
+		byte *data = createBenchmarkData();
+
+		Common::MemoryReadStream ms(data, kBenchmarkSize);
+		Common::BitStream32LELSB bs(ms);
+		uint32 start = getMicros();
+		uint32 streamSum = benchmarkGetBit(bs);
+		traceThroughput("BitStream32LELSB::getBit", kBenchmarkSize, getMicros() - start);
+
+		Common::BitStreamMemory32LELSB mbs(data, kBenchmarkSize);
+		start = getMicros();
+		uint32 memorySum = benchmarkGetBit(mbs);
+		traceThroughput("BitStreamMemory32LELSB::getBit", kBenchmarkSize, getMicros() - start);
+
+		TS_ASSERT_EQUALS(memorySum, streamSum);
+		delete[] data;
+	}
+
+	void test_benchmark_get_bits() {
+		byte *data = createBenchmarkData();
+
+		Common::MemoryReadStream ms(data, kBenchmarkSize);
+		Common::BitStream16LEMSB bs(ms);
+		uint32 start = getMicros();
+		uint32 streamSum = benchmarkGetBits(bs);
+		traceThroughput("BitStream16LEMSB::getBits", kBenchmarkSize, getMicros() - start);
+
+		Common::BitStreamMemory16LEMSB mbs(data, kBenchmarkSize);
+		start = getMicros();
+		uint32 memorySum = benchmarkGetBits(mbs);
+		traceThroughput("BitStreamMemory16LEMSB::getBits", kBenchmarkSize, getMicros() - start);
+
+		TS_ASSERT_EQUALS(memorySum, streamSum);
+		delete[] data;
+	}
 };
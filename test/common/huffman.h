@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bitstream.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+
+class HuffmanTestSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kCodeCount  = 13,
+		kSymbolCount = 3000
+	};
+
+	uint32 _codesMSB[kCodeCount];
+	uint32 _codesLSB[kCodeCount];
+	uint8  _lengths[kCodeCount];
+
+	byte _dataMSB[kSymbolCount * 2];
+	byte _dataLSB[kSymbolCount * 2];
+	uint32 _symbols[kSymbolCount];
+	uint32 _bits;
+
+	/**
+	 * Set up the codes 0, 10, 110, ... with lengths 1 to 12 and a last
+	 * code of all ones, so that several codes are longer than the
+	 * prefix table. Then encode a pseudo random sequence of them in both
+	 * bit orders.
+	 */
+	void setUp() {
+		for (uint32 i = 0; i < kCodeCount; i++) {
+			_lengths[i] = (i == kCodeCount - 1) ? kCodeCount - 1 : i + 1;
+			_codesMSB[i] = ((1 << _lengths[i]) - 1) & ~((i == kCodeCount - 1) ? 0 : 1);
+
+			_codesLSB[i] = 0;
+			for (uint32 j = 0; j < _lengths[i]; j++)
+				if (_codesMSB[i] & (1 << j))
+					_codesLSB[i] |= 1 << (_lengths[i] - 1 - j);
+		}
+
+		memset(_dataMSB, 0, sizeof(_dataMSB));
+		memset(_dataLSB, 0, sizeof(_dataLSB));
+		_bits = 0;
+
+		uint32 seed = 1;
+		for (uint32 i = 0; i < kSymbolCount; i++) {
+			seed = seed * 1103515245 + 12345;
+			// Mostly short codes, as in real data
+			uint32 symbol = (seed >> 16) % 16;
+			if (symbol >= kCodeCount)
+				symbol = (seed >> 20) % 4;
+			_symbols[i] = symbol;
+
+			for (int j = _lengths[symbol] - 1; j >= 0; j--, _bits++) {
+				if (_codesMSB[symbol] & (1 << j)) {
+					_dataMSB[_bits / 8] |= 0x80 >> (_bits % 8);
+					_dataLSB[_bits / 8] |= 1 << (_bits % 8);
+				}
+			}
+		}
+	}
+
+	void test_get_symbol_stream() {
+		Common::Huffman huffman(0, kCodeCount, _codesMSB, _lengths);
+
+		Common::MemoryReadStream ms(_dataMSB, sizeof(_dataMSB));
+		Common::BitStream8MSB bs(ms);
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bs), _symbols[i]);
+		TS_ASSERT_EQUALS(bs.pos(), _bits);
+	}
+
+	void test_get_symbol_memory_msb() {
+		Common::Huffman huffman(0, kCodeCount, _codesMSB, _lengths);
+
+		Common::BitStreamMemory8MSB bs(_dataMSB, sizeof(_dataMSB));
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bs), _symbols[i]);
+		TS_ASSERT_EQUALS(bs.pos(), _bits);
+	}
+
+	void test_get_symbol_memory_lsb() {
+		Common::Huffman huffman(0, kCodeCount, _codesLSB, _lengths);
+
+		Common::BitStreamMemory32LELSB bs(_dataLSB, sizeof(_dataLSB));
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bs), _symbols[i]);
+		TS_ASSERT_EQUALS(bs.pos(), _bits);
+	}
+
+	void test_set_symbols() {
+		uint32 symbols[kCodeCount];
+		for (uint32 i = 0; i < kCodeCount; i++)
+			symbols[i] = 100 + i;
+
+		Common::Huffman huffman(0, kCodeCount, _codesMSB, _lengths);
+		huffman.setSymbols(symbols);
+
+		Common::BitStreamMemory8MSB bs(_dataMSB, sizeof(_dataMSB));
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bs), 100 + _symbols[i]);
+	}
+
+	void test_code_at_end() {
+		// A single 1 bit code at the very end must decode even though
+		// the prefix table lookup peeks past it.
+		byte data[] = { 0x01 };
+		Common::Huffman huffman(0, kCodeCount, _codesMSB, _lengths);
+
+		Common::BitStreamMemory8MSB bs(data, sizeof(data));
+		for (uint32 i = 0; i < 7; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bs), 0u);
+		bs.skip(1);
+		TS_ASSERT(bs.eos());
+	}
+};
@@ -28,4 +28,20 @@ class MemoryWriteStreamTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(memcmp(buffer, data, sizeof(data)) == 0);
 		TS_ASSERT(!stream.err());
 	}
+
+	void test_write_dynamic() {
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+
+		for (uint i = 0; i < 1000; ++i)
+			stream.writeUint16LE(i);
+		TS_ASSERT_EQUALS(stream.size(), 2000u);
+		TS_ASSERT_EQUALS(stream.pos(), 2000u);
+
+		stream.seek(10);
+		stream.writeUint16LE(0xFFFF);
+		TS_ASSERT_EQUALS(stream.size(), 2000u);
+		TS_ASSERT_EQUALS(READ_LE_UINT16(stream.getData() + 8), 4);
+		TS_ASSERT_EQUALS(READ_LE_UINT16(stream.getData() + 10), 0xFFFF);
+		TS_ASSERT_EQUALS(READ_LE_UINT16(stream.getData() + 1998), 999);
+	}
 };
@@ -0,0 +1,259 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/engine.h"
+#include "engines/util.h"
+
+#include "kyra/kyra_v1.h"
+#include "kyra/resource.h"
+#include "kyra/screen.h"
+
+// The Screen object file is linked without the rest of the engine. These
+// stand in for everything else it references, drawShape uses none of them.
+void initGraphics(int width, int height, bool defaultTo1xScaler) {}
+bool Engine::shouldQuit() { return false; }
+
+namespace Kyra {
+
+uint8 *Resource::fileData(const char *file, uint32 *size) { return 0; }
+Common::SeekableReadStream *Resource::createReadStream(const Common::String &file) { return 0; }
+
+#ifdef ENABLE_EOB
+OldDOSFont::OldDOSFont(Common::RenderMode mode) : _data(0), _bitmapOffsets(0), _width(0), _height(0),
+	_colorMap(0), _numGlyphs(0), _renderMode(mode) {}
+OldDOSFont::~OldDOSFont() {}
+bool OldDOSFont::load(Common::SeekableReadStream &file) { return false; }
+int OldDOSFont::getCharWidth(uint16 c) const { return 0; }
+void OldDOSFont::drawChar(uint16 c, byte *dst, int pitch) const {}
+#endif
+
+} // End of namespace Kyra
+
+/**
+ * Screen with only the state drawShape uses. Screen::init() needs a
+ * backend, so the page and the draw layer buffers are set up here.
+ */
+class DrawShapeTestScreen : public Kyra::Screen {
+public:
+	enum {
+		kPage = 2
+	};
+
+	DrawShapeTestScreen(Kyra::KyraEngine_v1 *vm, const Kyra::ScreenDim *dimTable)
+	    : Kyra::Screen(vm, 0, dimTable, 1) {
+		memset(_sjisOverlayPtrs, 0, sizeof(_sjisOverlayPtrs));
+		_useOverlays = false;
+		_curPage = 0;
+		_screenPalette = _internFadePalette = 0;
+		_decodeShapeBuffer = _animBlockPtr = 0;
+		_customDimTable = new Kyra::ScreenDim *[1];
+		_customDimTable[0] = 0;
+
+		// The destructor frees page 0
+		_pagePtrs[0] = _pagePtrs[kPage] = new uint8[SCREEN_PAGE_SIZE];
+		memset(_pagePtrs[0], 0, SCREEN_PAGE_SIZE);
+
+		_shapePages[0] = new uint8[SCREEN_PAGE_SIZE];
+		_shapePages[1] = new uint8[SCREEN_PAGE_SIZE];
+		for (int i = 0; i < SCREEN_PAGE_SIZE; ++i) {
+			_shapePages[0][i] = (i * 7) & 0x87;
+			_shapePages[1][i] = (i & 0xFF) ^ 0x55;
+		}
+	}
+
+	~DrawShapeTestScreen() {
+		delete[] _shapePages[0];
+		delete[] _shapePages[1];
+	}
+
+	void setTextColorMap(const uint8 *cmap) {}
+	int getRectSize(int w, int h) { return 0; }
+
+	uint8 *getPage() { return _pagePtrs[kPage]; }
+
+	void reset() {
+		// Background pattern for the plot types which read the page
+		for (int i = 0; i < SCREEN_W * SCREEN_H; ++i)
+			_pagePtrs[kPage][i] = (i * 13 + i / SCREEN_W) & 0xFF;
+
+		_drawShapeVar1 = 0;
+		_drawShapeVar3 = 1;
+		_drawShapeVar4 = 0;
+		_drawShapeVar5 = 0;
+		_maskMinY = 24;
+		_maskMaxY = 30;
+	}
+};
+
+class KyraDrawShapeTestSuite : public CxxTest::TestSuite
+{
+	enum {
+		kShapeWidth = 24,
+		kShapeHeight = 16,
+		kDrawFlagCombinations = 8,
+		kPlotTypeCount = 21
+	};
+
+	static const int _plotTypes[kPlotTypeCount];
+	static const uint32 _expected[kPlotTypeCount][kDrawFlagCombinations];
+
+	uint8 _shape[1024];
+	uint8 _table[256];
+	uint8 _table2[256];
+	uint8 _table3[256];
+	uint8 _table4[0x8000];
+
+	/**
+	 * Build a raw shape (no frame compression), with the color table
+	 * drawShape skips for plot types with flag 0x400.
+	 */
+	void buildShape(bool colorTable) {
+		uint8 *dst = _shape;
+		WRITE_LE_UINT16(dst, 2); dst += 2;
+		*dst++ = kShapeHeight;
+		WRITE_LE_UINT16(dst, kShapeWidth); dst += 2;
+		*dst++ = 0; *dst++ = 0; *dst++ = 0;
+		uint8 *frameSize = dst; dst += 2;
+		const uint8 *frameStart = dst;
+
+		if (colorTable) {
+			for (int i = 0; i < 16; ++i)
+				*dst++ = 0xFF;
+		}
+
+		// Opaque pixels and transparent runs, pixel value 255 has a special
+		// meaning for some plot types and is never used
+		for (int y = 0; y < kShapeHeight; ++y) {
+			for (int x = 0; x < kShapeWidth;) {
+				if ((x * 5 + y * 3) % 11 == 0) {
+					const int run = MIN(1 + (x + y) % 4, kShapeWidth - x);
+					*dst++ = 0;
+					*dst++ = run;
+					x += run;
+				} else {
+					*dst++ = (x * 3 + y * 11) % 250 + 1;
+					++x;
+				}
+			}
+		}
+
+		WRITE_LE_UINT16(frameSize, dst - frameStart);
+	}
+
+	void buildTables() {
+		for (int i = 0; i < 256; ++i) {
+			_table[i] = (i * 13 + 7) % 251;
+			_table2[i] = (i * 37 + 11) % 255;
+			_table3[i] = (i % 3 == 0) ? 0x80 : (i & 0x7F);
+		}
+		for (int i = 0; i < 0x8000; ++i)
+			_table4[i] = (i ^ (i >> 7)) & 0xFF;
+	}
+
+	static uint32 checksum(const uint8 *data, uint32 size) {
+		uint32 a = 1, b = 0;
+		for (uint32 i = 0; i < size; ++i) {
+			a = (a + data[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	/**
+	 * Draw the shape once inside the page and once clipped at the top left
+	 * corner. The extra arguments drawShape reads depend on the plot type,
+	 * the scale factors come last and are ignored when not scaling.
+	 */
+	void draw(DrawShapeTestScreen &screen, int x, int y, int flags) {
+		const uint8 *shape = _shape;
+		const int page = DrawShapeTestScreen::kPage;
+		const int scale = 0x180;
+		const int layer = 3;
+		const int loopCount = 2;
+
+		flags |= 0x8000;
+		switch (flags & 0x1900) {
+		case 0x0000:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, scale, scale);
+			break;
+		case 0x0100:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, _table, loopCount, scale, scale);
+			break;
+		case 0x0800:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, layer, scale, scale);
+			break;
+		case 0x0900:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, _table, loopCount, layer, scale, scale);
+			break;
+		case 0x1000:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, _table3, _table4, scale, scale);
+			break;
+		case 0x1100:
+			screen.drawShape(page, shape, x, y, 0, flags, _table2, _table, loopCount, _table3, _table4, scale, scale);
+			break;
+		default:
+			TS_FAIL("Unexpected plot type flags");
+		}
+	}
+
+public:
+	void test_draw_shape() {
+		// drawShape only asks the engine for the game flags, which are all
+		// zero (Kyra 1 without the alternative shape header) here
+		static uint64 engineStorage[(sizeof(Kyra::KyraEngine_v1) + 7) / 8];
+		Kyra::KyraEngine_v1 *vm = (Kyra::KyraEngine_v1 *)engineStorage;
+
+		static const Kyra::ScreenDim dimTable[] = {
+			{ 0, 0, 40, 200, 0, 0, 0, 0 }
+		};
+
+		DrawShapeTestScreen screen(vm, dimTable);
+		buildTables();
+
+		for (int p = 0; p < kPlotTypeCount; ++p) {
+			const int plotFlags = _plotTypes[p] << 8;
+			buildShape((plotFlags & 0x400) != 0);
+
+			// Every combination of x flip, y flip and scaling
+			for (int f = 0; f < kDrawFlagCombinations; ++f) {
+				screen.reset();
+				draw(screen, 100, 20, plotFlags | f);
+				draw(screen, -5, -3, plotFlags | f);
+
+				const uint32 sum = checksum(screen.getPage(), Kyra::Screen::SCREEN_W * Kyra::Screen::SCREEN_H);
+				if (sum != _expected[p][f])
+					TS_FAIL(Common::String::format("Plot type %d, flags %d: checksum %08x, expected %08x",
+						_plotTypes[p], f, sum, _expected[p][f]).c_str());
+			}
+		}
+	}
+};
+
+const int KyraDrawShapeTestSuite::_plotTypes[] = {
+	0, 1, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15, 16, 20, 21, 33, 37, 48, 52
+};
+
+// Checksums of the page after drawing with the drawShape implementation
+// which called the plot functions through a member function pointer
+const uint32 KyraDrawShapeTestSuite::_expected[][8] = {
+	{ 0xf7c591d3, 0x8a8e8193, 0x7cec73a3, 0x18586307, 0x1c618221, 0xba9f78b7, 0xcc565ffd, 0x5bbc5653 },	// 0
+	{ 0x8e918735, 0x0eb881da, 0x02977fb1, 0x392d77f4, 0x50136bcd, 0x1b726ddd, 0x94ee7fbe, 0x06207e1c },	// 1
+	{ 0x07218999, 0x154d84c7, 0xf427842e, 0x68ac7f21, 0xa79e6cf7, 0x34637cda, 0x85d67c40, 0x70788568 },	// 3
+	{ 0x618a8df8, 0x1e1a8baa, 0x804f8aa2, 0xce7a8345, 0xb7f48369, 0x5f3b9292, 0x97339103, 0x95909944 },	// 4
+	{ 0x233f8df0, 0x13ef8a7e, 0xdaa288d9, 0xde3d82f0, 0x8eff7831, 0x5c717793, 0xff2c7ed4, 0xe63c7f5a },	// 5
+	{ 0x889f8f45, 0x957b82c7, 0xc9618841, 0xb3c57d39, 0x3a488e28, 0x42a489b9, 0x7da49106, 0x11c682b7 },	// 6
+	{ 0x07218999, 0x154d84c7, 0xf427842e, 0x68ac7f21, 0xa79e6cf7, 0x34637cda, 0x85d67c40, 0x70788568 },	// 7
+	{ 0xb5e59c13, 0xd46e8da7, 0x5a3b7c23, 0x27876c9b, 0x60f693b7, 0x9af187c1, 0x09666e13, 0x2f38621d },	// 8
+	{ 0x55868f34, 0xa2ab8ab9, 0xd48285b3, 0xbb547e53, 0x79b5730a, 0x0c3475e1, 0x71c4837b, 0xe14482e0 },	// 9
+	{ 0x3f448f2a, 0xb8218bc4, 0xe4648afa, 0xf5a6845e, 0x46827234, 0x456e828e, 0x70e181e9, 0xdad0891c },	// 11
+	{ 0xf0cc959f, 0x29159415, 0x1bff9089, 0xc7b18930, 0x7b4088b8, 0x628099a1, 0x0dee92d2, 0x53aa9d13 },	// 12
+	{ 0xe2bd9655, 0xafeb9765, 0xe0ff8f7e, 0xa1a98d57, 0xef93785e, 0xaac57f09, 0xd7e07b81, 0x06e98390 },	// 13
+	{ 0xf3139527, 0x76db9175, 0x0e5b8f64, 0x71fb8583, 0x93e89536, 0x182ca1c9, 0xa1bb949e, 0x0e0494c4 },	// 14
+	{ 0x3f448f2a, 0xb8218bc4, 0xe4648afa, 0xf5a6845e, 0x46827234, 0x456e828e, 0x70e181e9, 0xdad0891c },	// 15
+	{ 0x6f0e8015, 0x22a293ab, 0x808a83a2, 0x13a36a4b, 0x1c448876, 0x93e0881f, 0x0ff06a9e, 0x10e571db },	// 16
+	{ 0x6f1b8cc7, 0x82228977, 0x49b08939, 0xeabb8a9a, 0xd66480fa, 0x2c638760, 0x49b88ba4, 0x11458950 },	// 20
+	{ 0xbfaf8d24, 0xc02a8bd6, 0x00ab8ade, 0xc3c486ec, 0xc93a8209, 0xcac87d07, 0x80b87cd3, 0x1e8b851a },	// 21
+	{ 0x8e918735, 0x0eb881da, 0x02977fb1, 0x392d77f4, 0x50136bcd, 0x1b726ddd, 0x94ee7fbe, 0x06207e1c },	// 33
+	{ 0x233f8df0, 0x13ef8a7e, 0xdaa288d9, 0xde3d82f0, 0x8eff7831, 0x5c717793, 0xff2c7ed4, 0xe63c7f5a },	// 37
+	{ 0x6f0e8015, 0x22a293ab, 0x808a83a2, 0x13a36a4b, 0x1c448876, 0x93e0881f, 0x0ff06a9e, 0x10e571db },	// 48
+	{ 0x6f1b8cc7, 0x82228977, 0x49b08939, 0xeabb8a9a, 0xd66480fa, 0x2c638760, 0x49b88ba4, 0x11458950 },	// 52
+};
@@ -8,6 +8,13 @@
 TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
 TEST_LIBS    := audio/libaudio.a common/libcommon.a
 
+# The engine tests link single object files from the engine libraries, so
+# the engine has to be built in
+ifeq ($(ENABLE_KYRA), STATIC_PLUGIN)
+TESTS        += $(srcdir)/test/engines/kyra/*.h
+TEST_LIBS    := engines/kyra/libkyra.a graphics/libgraphics.a $(TEST_LIBS)
+endif
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
 TEST_CFLAGS  := -I$(srcdir)/test/cxxtest
@@ -31,7 +31,6 @@
 #include "common/textconsole.h"
 #include "common/math.h"
 #include "common/stream.h"
-#include "common/substream.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
@@ -154,6 +153,17 @@ void BinkDecoder::close() {
 
 	_audioTracks.clear();
 	_frames.clear();
+	_packet.clear();
+}
+
+const byte *BinkDecoder::readPacket(uint32 size) {
+	if (_packet.size() < size)
+		_packet.resize(size);
+
+	if (_bink->read(_packet.begin(), size) != size)
+		error("Failed to read Bink packet");
+
+	return _packet.begin();
 }
 
 void BinkDecoder::readNextPacket() {
@@ -188,8 +198,8 @@ void BinkDecoder::readNextPacket() {
 			//                  Number of samples in bytes
 			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-					audioPacketStart + 4, audioPacketEnd), true);
+			audio.bits = new Common::BitStreamMemory32LELSB(readPacket(audioPacketEnd - audioPacketStart - 4),
+					audioPacketEnd - audioPacketStart - 4);
 
 			audioTrack->decodePacket();
 
@@ -205,8 +215,8 @@ void BinkDecoder::readNextPacket() {
 	uint32 videoPacketStart = _bink->pos();
 	uint32 videoPacketEnd   = _bink->pos() + frameSize;
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), true);
+	frame.bits = new Common::BitStreamMemory32LELSB(readPacket(videoPacketEnd - videoPacketStart),
+			videoPacketEnd - videoPacketStart);
 
 	videoTrack->decodePacket(frame);
 
@@ -328,37 +338,58 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 		if (_id == kBIKiID)
 			frame.bits->skip(32);
 
-		decodePlane(frame, 3, false);
+		decodePlane(frame, 3, false, false);
 	}
 
 	if (_id == kBIKiID)
 		frame.bits->skip(32);
 
+	// The last plane converts its rows to RGB while they are still in the
+	// cache. If the packet ends early, convert the whole frame afterwards.
+	bool converted = false;
+
 	for (int i = 0; i < 3; i++) {
 		int planeIdx = ((i == 0) || !_swapPlanes) ? i : (i ^ 3);
 
-		decodePlane(frame, planeIdx, i != 0);
+		decodePlane(frame, planeIdx, i != 0, i == 2);
+		converted = (i == 2);
 
 		if (frame.bits->pos() >= frame.bits->size())
 			break;
 	}
 
+	if (!converted)
+		convertRows(0, _surfaceHeight);
+
+	// And swap the planes with the reference planes
+	for (int i = 0; i < 4; i++)
+		SWAP(_curPlanes[i], _oldPlanes[i]);
+
+	_curFrame++;
+}
+
+void BinkDecoder::BinkVideoTrack::convertRows(uint32 startRow, uint32 rowCount) {
 	// Convert the YUV data we have to our format
 	// We're ignoring alpha for now
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
 	assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-	YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
-			_surfaceWidth, _surfaceHeight, _surfaceWidth, _surfaceWidth >> 1);
+	assert(((startRow | rowCount) & 1) == 0);
 
-	// And swap the planes with the reference planes
-	for (int i = 0; i < 4; i++)
-		SWAP(_curPlanes[i], _oldPlanes[i]);
+	// A view on the rows of the surface we're converting
+	Graphics::Surface band = _surface;
+	band.pixels = _surface.getBasePtr(0, startRow);
+	band.h = rowCount;
 
-	_curFrame++;
+	uint32 yOffset  = startRow * _surfaceWidth;
+	uint32 uvOffset = (startRow >> 1) * (_surfaceWidth >> 1);
+
+	YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU,
+			_curPlanes[0] + yOffset, _curPlanes[1] + uvOffset, _curPlanes[2] + uvOffset,
+			_surfaceWidth, rowCount, _surfaceWidth, _surfaceWidth >> 1);
 }
 
-void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
+void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma, bool convert) {
 	uint32 blockWidth  = isChroma ? ((_surface.w  + 15) >> 4) : ((_surface.w  + 7) >> 3);
 	uint32 blockHeight = isChroma ? ((_surface.h + 15) >> 4) : ((_surface.h + 7) >> 3);
 	uint32 width       = isChroma ?  (_surface.w        >> 1) :   _surface.w;
@@ -451,6 +482,14 @@ void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, b
 
 		}
 
+		// A chroma block row covers 16 luma rows. Scaled blocks only ever
+		// write downwards, so these rows are final now.
+		if (convert) {
+			uint32 startRow = ctx.blockY * 16;
+
+			if (startRow < (uint32)_surfaceHeight)
+				convertRows(startRow, MIN<uint32>(16, _surfaceHeight - startRow));
+		}
 	}
 
 	if (video.bits->pos() & 0x1F) // next plane data starts at 32-bit boundary
@@ -1310,15 +1349,34 @@ static inline void IDCTCol(int16 *dest, const int16 *src) {
 	}
 }
 
+template<typename T>
+static inline void IDCTRow(T *dest, const int16 *src) {
+	// Most blocks only have low-frequency coefficients, leaving whole
+	// rows with nothing but a DC value after the column pass
+	if ((src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7]) == 0) {
+		const T dc = MUNGE_ROW(src[0]);
+
+		dest[0] =
+		dest[1] =
+		dest[2] =
+		dest[3] =
+		dest[4] =
+		dest[5] =
+		dest[6] =
+		dest[7] = dc;
+	} else {
+		IDCT_ROW(dest, src);
+	}
+}
+
 void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
 	int i;
 	int16 temp[64];
 
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&block[8*i], &temp[8*i]);
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
@@ -1336,9 +1394,8 @@ void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int16 *block) {
 	int16 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&ctx.dest[i*ctx.pitch], &temp[8*i]);
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio) : _audioInfo(&audio) {
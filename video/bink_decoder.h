@@ -32,6 +32,7 @@
 #define VIDEO_BINK_DECODER_H
 
 #include "common/array.h"
+#include "common/bitstream.h"
 #include "common/rational.h"
 
 #include "video/video_decoder.h"
@@ -45,7 +46,6 @@ class QueuingAudioStream;
 
 namespace Common {
 class SeekableReadStream;
-class BitStream;
 class Huffman;
 
 class RDFT;
@@ -98,7 +98,7 @@ private:
 
 		uint32 sampleCount;
 
-		Common::BitStream *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		bool first;
 
@@ -131,7 +131,7 @@ private:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream *bits;
+		Common::BitStreamMemory32LELSB *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -263,8 +263,16 @@ private:
 		/** Initialize the Huffman decoders. */
 		void initHuffman();
 
-		/** Decode a plane. */
-		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
+		/**
+		 * Decode a plane.
+		 *
+		 * If convert is set, the plane is the last one of the frame and
+		 * each finished row of blocks is converted to RGB right away.
+		 */
+		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma, bool convert);
+
+		/** Convert a band of rows of the current planes into the surface. */
+		void convertRows(uint32 startRow, uint32 rowCount);
 
 		/** Read/Initialize a bundle for decoding a plane. */
 		void readBundle(VideoFrame &video, Source source);
@@ -350,6 +358,11 @@ private:
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
+	Common::Array<byte> _packet; ///< Buffer for the packet being decoded.
+
+	/** Read a packet into the packet buffer. */
+	const byte *readPacket(uint32 size);
+
 	void initAudioTrack(AudioInfo &audio);
 };
 
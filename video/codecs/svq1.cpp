@@ -94,7 +94,12 @@ SVQ1Decoder::~SVQ1Decoder() {
 const Graphics::Surface *SVQ1Decoder::decodeImage(Common::SeekableReadStream *stream) {
 	debug(1, "SVQ1Decoder::decodeImage()");
 
-	Common::BitStream32BEMSB frameData(*stream);
+	uint32 frameSize = stream->size() - stream->pos();
+	if (_frameData.size() < frameSize)
+		_frameData.resize(frameSize);
+	stream->read(_frameData.begin(), frameSize);
+
+	Common::BitStreamMemory32BEMSB frameData(_frameData.begin(), frameSize);
 
 	uint32 frameCode = frameData.getBits(22);
 	debug(1, " frameCode: %d", frameCode);
@@ -282,7 +287,7 @@ const Graphics::Surface *SVQ1Decoder::decodeImage(Common::SeekableReadStream *st
 	return _surface;
 }
 
-bool SVQ1Decoder::svq1DecodeBlockIntra(Common::BitStream *s, byte *pixels, int pitch) {
+bool SVQ1Decoder::svq1DecodeBlockIntra(Common::BitStreamMemory32BEMSB *s, byte *pixels, int pitch) {
 	// initialize list for breadth first processing of vectors
 	byte *list[63];
 	list[0] = pixels;
@@ -383,7 +388,7 @@ bool SVQ1Decoder::svq1DecodeBlockIntra(Common::BitStream *s, byte *pixels, int p
 	return true;
 }
 
-bool SVQ1Decoder::svq1DecodeBlockNonIntra(Common::BitStream *s, byte *pixels, int pitch) {
+bool SVQ1Decoder::svq1DecodeBlockNonIntra(Common::BitStreamMemory32BEMSB *s, byte *pixels, int pitch) {
 	// initialize list for breadth first processing of vectors
 	byte *list[63];
 	list[0] = pixels;
@@ -497,7 +502,7 @@ static inline int midPred(int a, int b, int c) {
 	return b;
 }
 
-bool SVQ1Decoder::svq1DecodeMotionVector(Common::BitStream *s, Common::Point *mv, Common::Point **pmv) {
+bool SVQ1Decoder::svq1DecodeMotionVector(Common::BitStreamMemory32BEMSB *s, Common::Point *mv, Common::Point **pmv) {
 	for (int i = 0; i < 2; i++) {
 		// get motion code
 		int diff = _motionComponent->getSymbol(*s);
@@ -611,7 +616,7 @@ void SVQ1Decoder::putPixels16XY2C(byte *block, const byte *pixels, int lineSize,
 	putPixels8XY2C(block + 8, pixels + 8, lineSize, h);
 }
 
-bool SVQ1Decoder::svq1MotionInterBlock(Common::BitStream *ss, byte *current, byte *previous, int pitch,
+bool SVQ1Decoder::svq1MotionInterBlock(Common::BitStreamMemory32BEMSB *ss, byte *current, byte *previous, int pitch,
 		Common::Point *motion, int x, int y) {
 
 	// predict and decode motion vector
@@ -662,7 +667,7 @@ bool SVQ1Decoder::svq1MotionInterBlock(Common::BitStream *ss, byte *current, byt
 	return true;
 }
 
-bool SVQ1Decoder::svq1MotionInter4vBlock(Common::BitStream *ss, byte *current, byte *previous, int pitch,
+bool SVQ1Decoder::svq1MotionInter4vBlock(Common::BitStreamMemory32BEMSB *ss, byte *current, byte *previous, int pitch,
 		Common::Point *motion, int x, int y) {
 	// predict and decode motion vector (0)
 	Common::Point *pmv[4];
@@ -749,7 +754,7 @@ bool SVQ1Decoder::svq1MotionInter4vBlock(Common::BitStream *ss, byte *current, b
 	return true;
 }
 
-bool SVQ1Decoder::svq1DecodeDeltaBlock(Common::BitStream *ss, byte *current, byte *previous, int pitch,
+bool SVQ1Decoder::svq1DecodeDeltaBlock(Common::BitStreamMemory32BEMSB *ss, byte *current, byte *previous, int pitch,
 		Common::Point *motion, int x, int y) {
 	// get block type
 	uint32 blockType = _blockType->getSymbol(*ss);